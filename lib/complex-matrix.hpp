@@ -0,0 +1,191 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __COMPLEX_MATRIX_CPP
+#define __COMPLEX_MATRIX_CPP
+
+#include <stdexcept>
+
+#include "complex.hpp"
+#include "matrix.hpp"
+
+// Complex matrix stored as two real matrices, one with the real parts and
+// other with the imaginary parts, so products run on the real GEMM
+// kernel instead of going through Complex temporaries
+template <typename Floating>
+class Complex_Matrix {
+   private:
+    Matrix<Floating> re;
+    Matrix<Floating> im;
+
+    void check_product(const Complex_Matrix &matrix) const;
+
+   public:
+    explicit Complex_Matrix(const size_t rows, const size_t cols);
+    explicit Complex_Matrix(const Matrix<Floating> &real, const Matrix<Floating> &imag);
+    explicit Complex_Matrix(const Matrix<Complex<Floating>> &matrix);
+    size_t rows(void) const { return re.rows(); }
+    size_t cols(void) const { return re.cols(); }
+    Matrix<Floating> &real(void) { return re; }
+    const Matrix<Floating> &real(void) const { return re; }
+    Matrix<Floating> &imag(void) { return im; }
+    const Matrix<Floating> &imag(void) const { return im; }
+    Complex<Floating> operator()(const size_t row, const size_t col) const;
+    void set(const size_t row, const size_t col, const Complex<Floating> value);
+    Matrix<Complex<Floating>> to_matrix(void) const;
+    Complex_Matrix multiply_4m(const Complex_Matrix &matrix) const;
+    Complex_Matrix multiply_3m(const Complex_Matrix &matrix) const;
+    Complex_Matrix operator*(const Complex_Matrix &matrix) const;
+};
+
+template <typename Floating>
+Complex_Matrix<Floating>::Complex_Matrix(const size_t rows, const size_t cols) : re(rows, cols), im(rows, cols) {
+    re = static_cast<Floating>(0.0);
+    im = static_cast<Floating>(0.0);
+}
+
+template <typename Floating>
+Complex_Matrix<Floating>::Complex_Matrix(const Matrix<Floating> &real, const Matrix<Floating> &imag) : re(real), im(imag) {
+    if ((real.rows() != imag.rows()) || (real.cols() != imag.cols())) {
+        throw std::runtime_error("Trying to build a complex matrix from parts with different sizes!");
+    }
+}
+
+template <typename Floating>
+Complex_Matrix<Floating>::Complex_Matrix(const Matrix<Complex<Floating>> &matrix) : re(matrix.rows(), matrix.cols()), im(matrix.rows(), matrix.cols()) {
+    const Complex<Floating> *values = matrix.begin();
+    Floating *real = re.begin();
+    Floating *imag = im.begin();
+    for (size_t i = 0; i < matrix.rows() * matrix.cols(); i++) {
+        real[i] = values[i].real_part();
+        imag[i] = values[i].imag_part();
+    }
+}
+
+template <typename Floating>
+Complex<Floating> Complex_Matrix<Floating>::operator()(const size_t row, const size_t col) const {
+    return Complex<Floating>(re(row, col), im(row, col));
+}
+
+template <typename Floating>
+void Complex_Matrix<Floating>::set(const size_t row, const size_t col, const Complex<Floating> value) {
+    re(row, col) = value.real_part();
+    im(row, col) = value.imag_part();
+}
+
+template <typename Floating>
+Matrix<Complex<Floating>> Complex_Matrix<Floating>::to_matrix(void) const {
+    Matrix<Complex<Floating>> matrix(rows(), cols());
+    Complex<Floating> *values = matrix.begin();
+    const Floating *real = re.begin();
+    const Floating *imag = im.begin();
+    for (size_t i = 0; i < rows() * cols(); i++) {
+        values[i] = Complex<Floating>(real[i], imag[i]);
+    }
+    return matrix;
+}
+
+template <typename Floating>
+void Complex_Matrix<Floating>::check_product(const Complex_Matrix<Floating> &matrix) const {
+    if (cols() != matrix.rows()) {
+        throw std::runtime_error("Trying to multiply matrices with incompatible sizes!");
+    }
+}
+
+// Four real products: (Ar + i*Ai)(Br + i*Bi) = (Ar*Br - Ai*Bi) + i*(Ar*Bi + Ai*Br)
+template <typename Floating>
+Complex_Matrix<Floating> Complex_Matrix<Floating>::multiply_4m(const Complex_Matrix<Floating> &matrix) const {
+    check_product(matrix);
+    Complex_Matrix<Floating> result(rows(), matrix.cols());
+    Matrix<Floating> &real = result.re;
+    Matrix<Floating> &imag = result.im;
+    gemm(re.begin(), matrix.re.begin(), real.begin(), rows(), cols(), matrix.cols());
+    Matrix<Floating> product(rows(), matrix.cols());
+    product = static_cast<Floating>(0.0);
+    gemm(im.begin(), matrix.im.begin(), product.begin(), rows(), cols(), matrix.cols());
+    real = real - product;
+    gemm(re.begin(), matrix.im.begin(), imag.begin(), rows(), cols(), matrix.cols());
+    gemm(im.begin(), matrix.re.begin(), imag.begin(), rows(), cols(), matrix.cols());
+    return result;
+}
+
+// Three real products, trading one of them for three additions:
+// T1 = Ar*Br, T2 = Ai*Bi, T3 = (Ar + Ai)(Br + Bi), real = T1 - T2 and
+// imag = T3 - T1 - T2. The real part is as accurate as with 4M, but the
+// error of the imaginary part is bounded by |A|*|B| instead of by its own
+// magnitude, so it may lose digits when it is much smaller than the real
+// part.
+template <typename Floating>
+Complex_Matrix<Floating> Complex_Matrix<Floating>::multiply_3m(const Complex_Matrix<Floating> &matrix) const {
+    check_product(matrix);
+    Complex_Matrix<Floating> result(rows(), matrix.cols());
+    Matrix<Floating> &real = result.re;
+    Matrix<Floating> &imag = result.im;
+    Matrix<Floating> product(rows(), matrix.cols());
+    product = static_cast<Floating>(0.0);
+    gemm(re.begin(), matrix.re.begin(), real.begin(), rows(), cols(), matrix.cols());
+    gemm(im.begin(), matrix.im.begin(), product.begin(), rows(), cols(), matrix.cols());
+    const Matrix<Floating> sum_a = re + im;
+    const Matrix<Floating> sum_b = matrix.re + matrix.im;
+    gemm(sum_a.begin(), sum_b.begin(), imag.begin(), rows(), cols(), matrix.cols());
+    Floating *r = real.begin();
+    Floating *i = imag.begin();
+    const Floating *p = product.begin();
+    for (size_t k = 0; k < rows() * matrix.cols(); k++) {
+        i[k] -= r[k] + p[k];
+        r[k] -= p[k];
+    }
+    return result;
+}
+
+template <typename Floating>
+Complex_Matrix<Floating> Complex_Matrix<Floating>::operator*(const Complex_Matrix<Floating> &matrix) const {
+    return multiply_3m(matrix);
+}
+
+#endif  // __COMPLEX_MATRIX_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,384 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __COMPLEX_VECTOR_CPP
+#define __COMPLEX_VECTOR_CPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "complex.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "vector-math.hpp"
+#include "vector.hpp"
+
+// Array of complex numbers stored as two separate planes, one with the real
+// parts and other with the imaginary parts, each starting on a cache line.
+// Element-wise kernels then load Simd<Floating>::width real and imaginary
+// parts at once, with no shuffling, which Complex<Floating>, interleaved,
+// does not allow.
+template <typename Floating>
+class Complex_Vector {
+   private:
+    static constexpr size_t line_values = 64 / sizeof(Floating);
+
+    size_t len;
+    size_t stride;  // Distance between the two planes
+    std::unique_ptr<Floating[]> storage;
+    Floating *re;
+    Floating *im;
+
+    template <typename Kernel>
+    static void apply(const Complex_Vector &a, const Complex_Vector &b, Complex_Vector &result, const Kernel &kernel);
+
+   public:
+    explicit Complex_Vector(const size_t length);
+    explicit Complex_Vector(const Complex<Floating> *values, const size_t length);
+    explicit Complex_Vector(const std::vector<Complex<Floating>> &values) : Complex_Vector(values.data(), values.size()) {}
+    Complex_Vector(const Complex_Vector &to_copy);
+    Complex_Vector(Complex_Vector &&to_move);
+    Complex_Vector &operator=(const Complex_Vector &to_copy);
+    Complex_Vector &operator=(Complex_Vector &&to_move);
+    size_t length(void) const { return len; }
+    Floating *real(void) { return re; }
+    const Floating *real(void) const { return re; }
+    Floating *imag(void) { return im; }
+    const Floating *imag(void) const { return im; }
+    Complex<Floating> operator[](const size_t index) const;
+    void set(const size_t index, const Complex<Floating> value);
+    void to_complex(Complex<Floating> *values) const;
+    std::vector<Complex<Floating>> to_complex(void) const;
+    Complex_Vector operator+(const Complex_Vector &vector) const;
+    Complex_Vector operator-(const Complex_Vector &vector) const;
+    Complex_Vector operator*(const Complex_Vector &vector) const;
+    Complex_Vector operator/(const Complex_Vector &vector) const;
+    Complex_Vector &operator+=(const Complex_Vector &vector);
+    Complex_Vector &operator-=(const Complex_Vector &vector);
+    Complex_Vector &operator*=(const Complex_Vector &vector);
+    Complex_Vector &operator/=(const Complex_Vector &vector);
+    Complex_Vector conjugate_multiply(const Complex_Vector &vector) const;
+    Vector<Floating> modulus(void) const;
+    Vector<Floating> argument(void) const;
+};
+
+template <typename Floating>
+Complex_Vector<Floating>::Complex_Vector(const size_t length)
+    : len(length), stride(line_values * ((length + line_values - 1) / line_values)), storage(new Floating[2 * stride + line_values]) {
+    const uintptr_t misalignment = reinterpret_cast<uintptr_t>(storage.get()) % 64;
+    re = storage.get() + ((misalignment == 0) ? 0 : (64 - misalignment) / sizeof(Floating));
+    im = re + stride;
+    std::fill(re, re + len, static_cast<Floating>(0.0));
+    std::fill(im, im + len, static_cast<Floating>(0.0));
+    // The padding is read by the kernels, so it starts initialized. They may
+    // later store anything there, like the NaN of 0 / 0 in a division, but
+    // those lanes are never part of the vector
+    std::fill(re + len, re + stride, static_cast<Floating>(0.0));
+    std::fill(im + len, im + stride, static_cast<Floating>(0.0));
+}
+
+template <typename Floating>
+Complex_Vector<Floating>::Complex_Vector(const Complex<Floating> *values, const size_t length) : Complex_Vector(length) {
+    for (size_t i = 0; i < len; i++) {
+        re[i] = values[i].real_part();
+        im[i] = values[i].imag_part();
+    }
+}
+
+template <typename Floating>
+Complex_Vector<Floating>::Complex_Vector(const Complex_Vector<Floating> &to_copy) : Complex_Vector(to_copy.len) {
+    std::copy(to_copy.re, to_copy.re + len, re);
+    std::copy(to_copy.im, to_copy.im + len, im);
+}
+
+template <typename Floating>
+Complex_Vector<Floating>::Complex_Vector(Complex_Vector<Floating> &&to_move) : len(to_move.len), stride(to_move.stride), storage(std::move(to_move.storage)), re(to_move.re), im(to_move.im) {
+    to_move.len = 0;
+    to_move.stride = 0;
+    to_move.re = nullptr;
+    to_move.im = nullptr;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator=(Complex_Vector<Floating> &&to_move) {
+    if (this != &to_move) {
+        len = to_move.len;
+        stride = to_move.stride;
+        storage = std::move(to_move.storage);
+        re = to_move.re;
+        im = to_move.im;
+        to_move.len = 0;
+        to_move.stride = 0;
+        to_move.re = nullptr;
+        to_move.im = nullptr;
+    }
+    return *this;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator=(const Complex_Vector<Floating> &to_copy) {
+    if (this != &to_copy) {
+        *this = Complex_Vector<Floating>(to_copy);
+    }
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> Complex_Vector<Floating>::operator[](const size_t index) const {
+    if (index >= len) {
+        throw std::runtime_error("Trying to access complex vector in invalid range!");
+    }
+    return Complex<Floating>(re[index], im[index]);
+}
+
+template <typename Floating>
+void Complex_Vector<Floating>::set(const size_t index, const Complex<Floating> value) {
+    if (index >= len) {
+        throw std::runtime_error("Trying to access complex vector in invalid range!");
+    }
+    re[index] = value.real_part();
+    im[index] = value.imag_part();
+}
+
+template <typename Floating>
+void Complex_Vector<Floating>::to_complex(Complex<Floating> *values) const {
+    for (size_t i = 0; i < len; i++) {
+        values[i] = Complex<Floating>(re[i], im[i]);
+    }
+}
+
+template <typename Floating>
+std::vector<Complex<Floating>> Complex_Vector<Floating>::to_complex(void) const {
+    std::vector<Complex<Floating>> values(len);
+    to_complex(values.data());
+    return values;
+}
+
+// Element-wise kernels, called with packs of Simd<Floating>::width values
+struct Complex_Add {
+    template <typename Pack>
+    void operator()(const Pack a_re, const Pack a_im, const Pack b_re, const Pack b_im, Pack &real, Pack &imag) const {
+        real = a_re + b_re;
+        imag = a_im + b_im;
+    }
+};
+
+struct Complex_Subtract {
+    template <typename Pack>
+    void operator()(const Pack a_re, const Pack a_im, const Pack b_re, const Pack b_im, Pack &real, Pack &imag) const {
+        real = a_re - b_re;
+        imag = a_im - b_im;
+    }
+};
+
+struct Complex_Multiply {
+    template <typename Pack>
+    void operator()(const Pack a_re, const Pack a_im, const Pack b_re, const Pack b_im, Pack &real, Pack &imag) const {
+        real = a_re * b_re - a_im * b_im;
+        imag = a_re * b_im + a_im * b_re;
+    }
+};
+
+// Same formula as Complex::operator/, so results match element by element
+struct Complex_Divide {
+    template <typename Pack>
+    void operator()(const Pack a_re, const Pack a_im, const Pack b_re, const Pack b_im, Pack &real, Pack &imag) const {
+        const Pack squared_modulus = b_re * b_re + b_im * b_im;
+        real = (a_re * b_re + a_im * b_im) / squared_modulus;
+        imag = (a_im * b_re - a_re * b_im) / squared_modulus;
+    }
+};
+
+// a * conjugate(b), the product used by cross-correlation
+struct Complex_Conjugate_Multiply {
+    template <typename Pack>
+    void operator()(const Pack a_re, const Pack a_im, const Pack b_re, const Pack b_im, Pack &real, Pack &imag) const {
+        real = a_re * b_re + a_im * b_im;
+        imag = a_im * b_re - a_re * b_im;
+    }
+};
+
+// Runs the kernel over whole packs. Both planes are padded to whole cache
+// lines, which are multiples of the width, so the tail needs no special
+// case: whatever lands in the padding is ignored. The result may be one
+// of the operands, since each pack is loaded before it is stored
+template <typename Floating>
+template <typename Kernel>
+void Complex_Vector<Floating>::apply(const Complex_Vector<Floating> &a, const Complex_Vector<Floating> &b, Complex_Vector<Floating> &result, const Kernel &kernel) {
+    if ((a.len != b.len) || (a.len != result.len)) {
+        throw std::runtime_error("Operation involving complex vectors with incompatible lengths!");
+    }
+    typedef Simd<Floating> Pack;
+    const Floating *a_re = a.re;
+    const Floating *a_im = a.im;
+    const Floating *b_re = b.re;
+    const Floating *b_im = b.im;
+    Floating *r_re = result.re;
+    Floating *r_im = result.im;
+    parallel_for((a.len + Pack::width - 1) / Pack::width, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin * Pack::width; i < end * Pack::width; i += Pack::width) {
+            Pack real, imag;
+            kernel(Pack::load(a_re + i), Pack::load(a_im + i), Pack::load(b_re + i), Pack::load(b_im + i), real, imag);
+            real.store(r_re + i);
+            imag.store(r_im + i);
+        }
+    });
+}
+
+template <typename Floating>
+Complex_Vector<Floating> Complex_Vector<Floating>::operator+(const Complex_Vector<Floating> &vector) const {
+    Complex_Vector<Floating> result(len);
+    apply(*this, vector, result, Complex_Add());
+    return result;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator+=(const Complex_Vector<Floating> &vector) {
+    apply(*this, vector, *this, Complex_Add());
+    return *this;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> Complex_Vector<Floating>::operator-(const Complex_Vector<Floating> &vector) const {
+    Complex_Vector<Floating> result(len);
+    apply(*this, vector, result, Complex_Subtract());
+    return result;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator-=(const Complex_Vector<Floating> &vector) {
+    apply(*this, vector, *this, Complex_Subtract());
+    return *this;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> Complex_Vector<Floating>::operator*(const Complex_Vector<Floating> &vector) const {
+    Complex_Vector<Floating> result(len);
+    apply(*this, vector, result, Complex_Multiply());
+    return result;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator*=(const Complex_Vector<Floating> &vector) {
+    apply(*this, vector, *this, Complex_Multiply());
+    return *this;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> Complex_Vector<Floating>::operator/(const Complex_Vector<Floating> &vector) const {
+    Complex_Vector<Floating> result(len);
+    apply(*this, vector, result, Complex_Divide());
+    return result;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> &Complex_Vector<Floating>::operator/=(const Complex_Vector<Floating> &vector) {
+    apply(*this, vector, *this, Complex_Divide());
+    return *this;
+}
+
+template <typename Floating>
+Complex_Vector<Floating> Complex_Vector<Floating>::conjugate_multiply(const Complex_Vector<Floating> &vector) const {
+    Complex_Vector<Floating> result(len);
+    apply(*this, vector, result, Complex_Conjugate_Multiply());
+    return result;
+}
+
+template <typename Floating>
+Vector<Floating> Complex_Vector<Floating>::modulus(void) const {
+    typedef Simd<Floating> Pack;
+    Vector<Floating> result(len);
+    const Floating *a_re = re;
+    const Floating *a_im = im;
+    Floating *r = result.begin();
+    // The last pack may read the padding of the planes, but only the
+    // values which belong to the vector are stored
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        size_t i = begin;
+        for (; i + Pack::width <= end; i += Pack::width) {
+            const Pack real = Pack::load(a_re + i);
+            const Pack imag = Pack::load(a_im + i);
+            sqrt(real * real + imag * imag).store(r + i);
+        }
+        if (i < end) {
+            const Pack real = Pack::load(a_re + i);
+            const Pack imag = Pack::load(a_im + i);
+            Floating tail[Pack::width];
+            sqrt(real * real + imag * imag).store(tail);
+            std::copy(tail, tail + (end - i), r + i);
+        }
+    });
+    return result;
+}
+
+template <typename Floating>
+Vector<Floating> Complex_Vector<Floating>::argument(void) const {
+    typedef Simd<Floating> Pack;
+    Vector<Floating> result(len);
+    const Floating *a_re = re;
+    const Floating *a_im = im;
+    Floating *r = result.begin();
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        size_t i = begin;
+        for (; i + Pack::width <= end; i += Pack::width) {
+            atan2(Pack::load(a_im + i), Pack::load(a_re + i)).store(r + i);
+        }
+        if (i < end) {
+            Floating tail[Pack::width];
+            atan2(Pack::load(a_im + i), Pack::load(a_re + i)).store(tail);
+            std::copy(tail, tail + (end - i), r + i);
+        }
+    });
+    return result;
+}
+
+#endif  // __COMPLEX_VECTOR_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -43,6 +43,8 @@ class Complex {
     explicit Complex(void) : real(0), imag(0){};
     std::string to_string(void) const;
     static Complex<Floating> from_polar(Floating modulus, Floating phase);
+    Floating real_part(void) const;
+    Floating imag_part(void) const;
     Floating modulus(void) const;
     Floating argument(void) const;
     Complex<Floating> conjugate(void) const;
@@ -55,6 +57,13 @@ class Complex {
     Complex<Floating> operator*(Floating b) const;
     Complex<Floating> operator/(Complex<Floating> b) const;
     Complex<Floating> operator/(Floating b) const;
+    Complex<Floating> operator-(void) const;
+    Complex<Floating> &operator+=(Complex<Floating> b);
+    Complex<Floating> &operator-=(Complex<Floating> b);
+    Complex<Floating> &operator*=(Complex<Floating> b);
+    Complex<Floating> &operator*=(Floating b);
+    Complex<Floating> &operator/=(Complex<Floating> b);
+    Complex<Floating> &operator/=(Floating b);
     bool operator==(Complex<Floating> b) const;
     bool operator==(Floating b) const;
 };
@@ -84,9 +93,19 @@ std::string Complex<Floating>::to_string(void) const {
 
 template <typename Floating>
 Complex<Floating> Complex<Floating>::from_polar(const Floating modulus, const Floating phase) {
-    Floating real = modulus * cosine<Floating>(phase);
-    Floating imag = modulus * sine<Floating>(phase);
-    return Complex<Floating>(real, imag);
+    Floating s, c;
+    sincos(phase, s, c);
+    return Complex<Floating>(modulus * c, modulus * s);
+}
+
+template <typename Floating>
+Floating Complex<Floating>::real_part(void) const {
+    return real;
+}
+
+template <typename Floating>
+Floating Complex<Floating>::imag_part(void) const {
+    return imag;
 }
 
 template <typename Floating>
@@ -177,6 +196,47 @@ Complex<Floating> operator/(Floating b, Complex<Floating> a) {
     return (a / b);
 }
 
+template <typename Floating>
+Complex<Floating> Complex<Floating>::operator-(void) const {
+    return Complex<Floating>(-real, -imag);
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator+=(Complex<Floating> b) {
+    *this = *this + b;
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator-=(Complex<Floating> b) {
+    *this = *this - b;
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator*=(Complex<Floating> b) {
+    *this = *this * b;
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator*=(Floating b) {
+    *this = *this * b;
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator/=(Complex<Floating> b) {
+    *this = *this / b;
+    return *this;
+}
+
+template <typename Floating>
+Complex<Floating> &Complex<Floating>::operator/=(Floating b) {
+    *this = *this / b;
+    return *this;
+}
+
 template <typename Floating>
 bool Complex<Floating>::operator==(Complex<Floating> b) const {
     return (are_close<Floating>(real, b.real, complex_precision)) && (are_close<Floating>(imag, b.imag, complex_precision));
@@ -192,6 +252,14 @@ Complex<Floating> operator==(Floating b, Complex<Floating> a) {
     return (a == b);
 }
 
+// Compares both parts against the real part of delta, so containers such
+// as Matrix, which call are_close on their elements, can hold complex
+// numbers
+template <typename Floating>
+bool are_close(const Complex<Floating> a, const Complex<Floating> b, const Complex<Floating> delta) {
+    return are_close(a.real_part(), b.real_part(), delta.real_part()) && are_close(a.imag_part(), b.imag_part(), delta.real_part());
+}
+
 #endif  // __COMPLEX_CPP
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,316 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __CONCURRENT_ARRAY_CPP
+#define __CONCURRENT_ARRAY_CPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+constexpr size_t concurrent_array_chunk_length = 1 << 10;
+
+// Append-only array which many threads can push to at once, without
+// locks, while other threads read it. A push reserves a slot with an
+// atomic increment, so pushes never wait for each other. The slots are in
+// chunks listed in a directory of fixed size, where the chunk k holds
+// (chunk_length << k) elements, so the directory is never reallocated,
+// the elements never move, and the chunk of an index is found with a
+// leading zero count. The first thread which needs a chunk allocates it,
+// and publishes it with a compare-and-swap. A thread whose element is built
+// advances the length if it reached its slot, and otherwise sets the flag
+// of the slot. Then it advances the length over the flagged slots, so
+// readers only see the prefix of elements which were completely built.
+// If building an element throws, its slot is never ready and the length
+// stops before it
+template <typename Number, size_t chunk_length = concurrent_array_chunk_length>
+class Concurrent_Array {
+   private:
+    static_assert((chunk_length != 0) && ((chunk_length & (chunk_length - 1)) == 0), "The chunk length of a concurrent array must be a power of two");
+    static_assert(alignof(Number) <= alignof(std::max_align_t), "Concurrent_Array allocates with malloc, which does not support over-aligned types");
+
+    // Chunks sized up to the whole address space
+    static constexpr size_t directory_length = 8 * sizeof(size_t);
+
+    std::atomic<char *> chunks[directory_length];
+    std::atomic<size_t> reserved;
+    std::atomic<size_t> published;
+
+    static size_t chunk_of(const size_t index) { return static_cast<size_t>(8 * sizeof(unsigned long long) - 1 - static_cast<size_t>(__builtin_clzll(index / chunk_length + 1))); }
+    static size_t chunk_first(const size_t chunk) { return chunk_length * ((static_cast<size_t>(1) << chunk) - 1); }
+    static size_t chunk_size(const size_t chunk) { return chunk_length << chunk; }
+    static size_t flags_offset(const size_t chunk) {
+        const size_t bytes = chunk_size(chunk) * sizeof(Number);
+        return (bytes + alignof(std::atomic<bool>) - 1) / alignof(std::atomic<bool>) * alignof(std::atomic<bool>);
+    }
+    char *chunk_at(const size_t chunk);
+    Number *slot(const size_t index) const;
+    bool is_ready(const size_t index) const;
+    void publish(void);
+
+   public:
+    Concurrent_Array(void);
+    Concurrent_Array(const Concurrent_Array &to_copy) = delete;
+    ~Concurrent_Array(void);
+    Concurrent_Array &operator=(const Concurrent_Array &to_copy) = delete;
+    std::string to_string(void) const;
+    size_t length(void) const { return published.load(std::memory_order_acquire); }
+    size_t capacity(void) const;
+    template <typename... Arguments>
+    size_t emplace_back(Arguments &&...arguments);
+    size_t push(const Number &value);
+    size_t push(Number &&value);
+    Number value_at(const size_t index) const;
+    size_t find(const Number &value) const;
+    Number &operator[](const size_t index) const;
+
+    // Iterators over the elements published when end() was called
+    template <bool Const>
+    class Concurrent_Iterator;
+    Concurrent_Iterator<false> begin(void) { return Concurrent_Iterator<false>(this, 0); }
+    Concurrent_Iterator<false> end(void) { return Concurrent_Iterator<false>(this, length()); }
+    Concurrent_Iterator<true> begin(void) const { return Concurrent_Iterator<true>(this, 0); }
+    Concurrent_Iterator<true> end(void) const { return Concurrent_Iterator<true>(this, length()); }
+};
+
+template <typename Number, size_t chunk_length>
+template <bool Const>
+class Concurrent_Array<Number, chunk_length>::Concurrent_Iterator {
+   private:
+    typedef typename std::conditional<Const, const Concurrent_Array, Concurrent_Array>::type Array;
+    typedef typename std::conditional<Const, const Number, Number>::type Element;
+
+    Array *array;
+    size_t index;
+
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Number value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Element *pointer;
+    typedef Element &reference;
+
+    Concurrent_Iterator(Array *array, const size_t index) : array(array), index(index) {}
+    Element &operator*(void) const { return *array->slot(index); }
+    Element *operator->(void) const { return &**this; }
+    Concurrent_Iterator &operator++(void) {
+        index++;
+        return *this;
+    }
+    Concurrent_Iterator operator++(int) {
+        Concurrent_Iterator previous = *this;
+        index++;
+        return previous;
+    }
+    bool operator!=(const Concurrent_Iterator &it) const { return (index != it.index); }
+    bool operator==(const Concurrent_Iterator &it) const { return (index == it.index); }
+};
+
+template <typename Number, size_t chunk_length>
+Concurrent_Array<Number, chunk_length>::Concurrent_Array(void) : reserved(0), published(0) {
+    for (size_t i = 0; i < directory_length; i++) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+// No thread may be pushing while the array is destroyed
+template <typename Number, size_t chunk_length>
+Concurrent_Array<Number, chunk_length>::~Concurrent_Array(void) {
+    const size_t len = published.load();
+    const size_t count = reserved.load();
+    for (size_t i = 0; i < count; i++) {
+        if ((i < len) || is_ready(i)) {
+            slot(i)->~Number();
+        }
+    }
+    for (size_t i = 0; i < directory_length; i++) {
+        std::free(chunks[i].load(std::memory_order_relaxed));
+    }
+}
+
+template <typename Number, size_t chunk_length>
+std::ostream &operator<<(std::ostream &os, const Concurrent_Array<Number, chunk_length> &array) {
+    return os << array.to_string();
+}
+
+template <typename Number, size_t chunk_length>
+std::string Concurrent_Array<Number, chunk_length>::to_string(void) const {
+    std::ostringstream strs;
+    const size_t len = length();
+    strs << "Array length: " << len << ", capacity: " << capacity() << std::endl;
+    for (size_t i = 0; i < len; i++) {
+        strs << "[" << std::setw(3) << i << "]: " << *slot(i) << std::endl;
+    }
+    return strs.str();
+}
+
+template <typename Number, size_t chunk_length>
+size_t Concurrent_Array<Number, chunk_length>::capacity(void) const {
+    size_t chunk = 0;
+    while ((chunk < directory_length) && (chunks[chunk].load(std::memory_order_acquire) != nullptr)) {
+        chunk++;
+    }
+    return chunk_first(chunk);
+}
+
+// Returns the chunk, allocating it if no other thread did. The thread
+// which loses the race frees its allocation and uses the other one. The
+// flags are after the elements, cleared by calloc
+template <typename Number, size_t chunk_length>
+char *Concurrent_Array<Number, chunk_length>::chunk_at(const size_t chunk) {
+    char *memory = chunks[chunk].load(std::memory_order_acquire);
+    if (memory != nullptr) {
+        return memory;
+    }
+    char *allocated = static_cast<char *>(std::calloc(flags_offset(chunk) + chunk_size(chunk) * sizeof(std::atomic<bool>), 1));
+    if (allocated == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (chunks[chunk].compare_exchange_strong(memory, allocated, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return allocated;
+    }
+    std::free(allocated);
+    return memory;
+}
+
+template <typename Number, size_t chunk_length>
+Number *Concurrent_Array<Number, chunk_length>::slot(const size_t index) const {
+    const size_t chunk = chunk_of(index);
+    return reinterpret_cast<Number *>(chunks[chunk].load(std::memory_order_acquire)) + (index - chunk_first(chunk));
+}
+
+// The chunk of a reserved slot may not be allocated yet
+template <typename Number, size_t chunk_length>
+bool Concurrent_Array<Number, chunk_length>::is_ready(const size_t index) const {
+    const size_t chunk = chunk_of(index);
+    char *memory = chunks[chunk].load(std::memory_order_acquire);
+    return (memory != nullptr) && reinterpret_cast<std::atomic<bool> *>(memory + flags_offset(chunk))[index - chunk_first(chunk)].load();
+}
+
+// Advances the length over the ready slots. The flags and the length use
+// sequentially consistent operations, so when two threads set their flags
+// at once, at least one of them sees the flag of the other
+template <typename Number, size_t chunk_length>
+void Concurrent_Array<Number, chunk_length>::publish(void) {
+    size_t len = published.load();
+    while ((len < reserved.load()) && is_ready(len)) {
+        // On failure, len receives the length set by the other thread
+        if (published.compare_exchange_weak(len, len + 1)) {
+            len++;
+        }
+    }
+}
+
+// Returns the index of the new element, which is only readable through
+// length() and the iterators once the elements before it are also built
+template <typename Number, size_t chunk_length>
+template <typename... Arguments>
+size_t Concurrent_Array<Number, chunk_length>::emplace_back(Arguments &&...arguments) {
+    const size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+    const size_t chunk = chunk_of(index);
+    char *memory = chunk_at(chunk);
+    const size_t offset = index - chunk_first(chunk);
+    new (reinterpret_cast<Number *>(memory) + offset) Number(std::forward<Arguments>(arguments)...);
+    // Only this thread can advance the length past its own slot, so it
+    // does not need the flag when the length already reached it
+    if (published.load() == index) {
+        published.store(index + 1);
+    } else {
+        reinterpret_cast<std::atomic<bool> *>(memory + flags_offset(chunk))[offset].store(true);
+    }
+    publish();
+    return index;
+}
+
+template <typename Number, size_t chunk_length>
+size_t Concurrent_Array<Number, chunk_length>::push(const Number &value) {
+    return emplace_back(value);
+}
+
+template <typename Number, size_t chunk_length>
+size_t Concurrent_Array<Number, chunk_length>::push(Number &&value) {
+    return emplace_back(std::move(value));
+}
+
+template <typename Number, size_t chunk_length>
+Number Concurrent_Array<Number, chunk_length>::value_at(const size_t index) const {
+    if (index >= length()) {
+        throw std::runtime_error("Trying to access the array in invalid range!");
+    }
+    return *slot(index);
+}
+
+template <typename Number, size_t chunk_length>
+size_t Concurrent_Array<Number, chunk_length>::find(const Number &value) const {
+    // Sequential search over the published elements
+    const size_t len = length();
+    for (size_t i = 0; i < len; i++) {
+        if (*slot(i) == value) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Didn't found the requested value in the array!");
+}
+
+template <typename Number, size_t chunk_length>
+Number &Concurrent_Array<Number, chunk_length>::operator[](const size_t index) const {
+    if (index >= length()) {
+        throw std::runtime_error("Trying to access concurrent array in invalid range!");
+    }
+    return *slot(index);
+}
+
+#endif  // __CONCURRENT_ARRAY_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
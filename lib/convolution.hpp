@@ -0,0 +1,232 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __CONVOLUTION_CPP
+#define __CONVOLUTION_CPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "complex.hpp"
+#include "fft.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+
+// Kernels up to this length are convolved directly. Above it, the
+// O(log n) cost per output of the FFT beats the O(kernel) direct sum
+constexpr size_t convolution_direct_limit = 48;
+
+// Causal convolution of a stream, by overlap-save: each block of the FFT
+// holds the last kernel - 1 inputs followed by block_length() new ones,
+// and the circular convolution with the kernel leaves the outputs of the
+// new samples uncorrupted. Any number of samples can be processed per
+// call, with no latency: outputs of a block which is still incomplete are
+// summed directly, and the rest of the block goes through the FFT once it
+// is complete.
+template <typename Floating>
+class Stream_Convolution {
+   private:
+    size_t taps;
+    std::vector<Floating> coefficients;
+    Real_FFT_Plan<Floating> plan;
+    std::vector<Complex<Floating>> kernel_spectrum;
+    std::vector<Floating> buffer;  // taps - 1 previous inputs, then the block
+    std::vector<Floating> result;
+    std::vector<Complex<Floating>> spectrum;
+    size_t pending;  // Inputs of the current block
+
+    void convolve_block(Floating *output, const size_t first);
+
+   public:
+    explicit Stream_Convolution(const Vector<Floating> &kernel);
+    size_t block_length(void) const { return plan.length() - (taps - 1); }
+    void process(const Floating *input, Floating *output, const size_t count);
+    Vector<Floating> process(const Vector<Floating> &input);
+    void reset(void);
+};
+
+template <typename Floating>
+Stream_Convolution<Floating>::Stream_Convolution(const Vector<Floating> &kernel)
+    : taps(kernel.length()), coefficients(kernel.begin(), kernel.end()), plan(next_power_of_two(4 * maximum<size_t>(kernel.length(), 1))), pending(0) {
+    if (taps == 0) {
+        throw std::runtime_error("Trying to convolve with an empty kernel!");
+    }
+    const size_t length = plan.length();
+    buffer.assign(length, static_cast<Floating>(0.0));
+    result.assign(length, static_cast<Floating>(0.0));
+    std::copy(kernel.begin(), kernel.end(), buffer.begin());
+    kernel_spectrum.assign(plan.spectrum_length(), Complex<Floating>());
+    spectrum.assign(plan.spectrum_length(), Complex<Floating>());
+    plan.forward(buffer.data(), kernel_spectrum.data());
+    std::fill(buffer.begin(), buffer.end(), static_cast<Floating>(0.0));
+}
+
+template <typename Floating>
+void Stream_Convolution<Floating>::reset(void) {
+    std::fill(buffer.begin(), buffer.end(), static_cast<Floating>(0.0));
+    pending = 0;
+}
+
+// The first taps - 1 outputs of the circular convolution are wrapped
+// around. Of the other ones, those before first were already summed
+// directly. Afterwards, the inputs the next block needs are moved to the
+// front of the buffer
+template <typename Floating>
+void Stream_Convolution<Floating>::convolve_block(Floating *output, const size_t first) {
+    const size_t history = taps - 1;
+    plan.forward(buffer.data(), spectrum.data());
+    for (size_t k = 0; k < spectrum.size(); k++) {
+        spectrum[k] = spectrum[k] * kernel_spectrum[k];
+    }
+    plan.inverse(spectrum.data(), result.data());
+    std::copy(result.begin() + static_cast<std::ptrdiff_t>(history + first), result.end(), output);
+    std::copy(buffer.end() - static_cast<std::ptrdiff_t>(history), buffer.end(), buffer.begin());
+}
+
+template <typename Floating>
+void Stream_Convolution<Floating>::process(const Floating *input, Floating *output, const size_t count) {
+    const size_t history = taps - 1;
+    const size_t block = block_length();
+    size_t done = 0;
+    while (done < count) {
+        const size_t first = pending;
+        const size_t take = minimum(block - pending, count - done);
+        std::copy(input + done, input + done + take, buffer.begin() + static_cast<std::ptrdiff_t>(history + first));
+        pending += take;
+        if (pending == block) {
+            convolve_block(output + done, first);
+            pending = 0;
+        } else {
+            for (size_t p = first; p < pending; p++) {
+                Floating sum = static_cast<Floating>(0.0);
+                for (size_t k = 0; k < taps; k++) {
+                    sum += coefficients[k] * buffer[history + p - k];
+                }
+                output[done + p - first] = sum;
+            }
+        }
+        done += take;
+    }
+}
+
+template <typename Floating>
+Vector<Floating> Stream_Convolution<Floating>::process(const Vector<Floating> &input) {
+    Vector<Floating> output(input.length());
+    process(input.begin(), output.begin(), input.length());
+    return output;
+}
+
+// Full convolution, with signal.length() + kernel.length() - 1 outputs
+template <typename Floating>
+Vector<Floating> direct_convolution(const Vector<Floating> &signal, const Vector<Floating> &kernel) {
+    if ((signal.length() == 0) || (kernel.length() == 0)) {
+        throw std::runtime_error("Trying to convolve an empty vector!");
+    }
+    const size_t length = signal.length() + kernel.length() - 1;
+    Vector<Floating> result(length);
+    const Floating *x = signal.begin();
+    const Floating *h = kernel.begin();
+    const size_t signal_length = signal.length();
+    const size_t taps = kernel.length();
+    Floating *y = result.begin();
+    parallel_for(length, [=](const size_t begin, const size_t end) {
+        for (size_t n = begin; n < end; n++) {
+            const size_t first = (n >= signal_length) ? (n - signal_length + 1) : 0;
+            const size_t last = minimum(n + 1, taps);
+            Floating sum = static_cast<Floating>(0.0);
+            for (size_t k = first; k < last; k++) {
+                sum += h[k] * x[n - k];
+            }
+            y[n] = sum;
+        }
+    });
+    return result;
+}
+
+// Full convolution by overlap-save, feeding kernel.length() - 1 zeros
+// after the signal to flush the tail
+template <typename Floating>
+Vector<Floating> fft_convolution(const Vector<Floating> &signal, const Vector<Floating> &kernel) {
+    if ((signal.length() == 0) || (kernel.length() == 0)) {
+        throw std::runtime_error("Trying to convolve an empty vector!");
+    }
+    Stream_Convolution<Floating> stream(kernel);
+    Vector<Floating> result(signal.length() + kernel.length() - 1);
+    stream.process(signal.begin(), result.begin(), signal.length());
+    const std::vector<Floating> zeros(kernel.length() - 1, static_cast<Floating>(0.0));
+    stream.process(zeros.data(), result.begin() + signal.length(), zeros.size());
+    return result;
+}
+
+// Convolution is commutative, so the shorter vector is used as the kernel,
+// and the method is picked by its length
+template <typename Floating>
+Vector<Floating> convolve(const Vector<Floating> &signal, const Vector<Floating> &kernel) {
+    const Vector<Floating> &longer = (signal.length() >= kernel.length()) ? signal : kernel;
+    const Vector<Floating> &shorter = (signal.length() >= kernel.length()) ? kernel : signal;
+    if (shorter.length() <= convolution_direct_limit) {
+        return direct_convolution(longer, shorter);
+    }
+    return fft_convolution(longer, shorter);
+}
+
+// Cross-correlation, r[k] = sum(signal[n + k - (kernel.length() - 1)] * kernel[n]),
+// so the lag of r[k] is k - (kernel.length() - 1). It is the convolution
+// with the reversed kernel
+template <typename Floating>
+Vector<Floating> correlate(const Vector<Floating> &signal, const Vector<Floating> &kernel) {
+    Vector<Floating> reversed(kernel.length());
+    for (size_t i = 0; i < kernel.length(); i++) {
+        reversed[i] = kernel[kernel.length() - 1 - i];
+    }
+    return convolve(signal, reversed);
+}
+
+#endif  // __CONVOLUTION_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -23,52 +23,154 @@
 #ifndef __DYNAMIC_ARRAY_CPP
 #define __DYNAMIC_ARRAY_CPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
+#include <iterator>
+#include <new>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 constexpr size_t initial_array_capacity = 4;
 
+// Array which grows on demand at both ends. The elements are contiguous,
+// but may start after a gap at the front of the storage, so shift and
+// unshift only move the start, as pop and push move the end. When one end
+// runs out of room, the elements slide back into a half empty buffer, or
+// move to one twice as large, which keeps every operation amortized O(1).
+// The storage is raw memory, and elements are constructed in place only
+// when they are inserted. Relocation moves the elements, or copies them if
+// their move constructor may throw, and trivially copyable types are grown
+// with realloc, which can extend the block in place (glibc remaps large
+// blocks with mremap, without copying)
 template <typename Number>
 class Dynamic_Array {
    private:
-    Number *values;
-    size_t capacity;
-    size_t length;
+    Number *storage;
+    Number *values;  // First element, after the front gap
+    size_t _capacity;
+    size_t len;
 
-    void grow_capacity_if_needed(void);
+    size_t front_gap(void) const { return static_cast<size_t>(values - storage); }
+    size_t grown_capacity(void) const { return (_capacity == 0) ? initial_array_capacity : 2 * _capacity; }
+    typedef std::integral_constant<bool, std::is_trivially_copyable<Number>::value> trivially_copyable;
+
+    static Number *allocate(const size_t capacity);
+    static void destroy(Number *first, const size_t count);
+    static void construct_moved(Number *source, const size_t count, Number *destination);
+    static void construct_moved(Number *source, const size_t count, Number *destination, std::true_type);
+    static void construct_moved(Number *source, const size_t count, Number *destination, std::false_type);
+    static void move_elements(Number *source, const size_t count, Number *destination);
+    static void move_elements(Number *source, const size_t count, Number *destination, std::true_type);
+    static void move_elements(Number *source, const size_t count, Number *destination, std::false_type);
+    void relocate(const size_t capacity, const size_t front);
+    void relocate(const size_t capacity, const size_t front, std::true_type);
+    void relocate(const size_t capacity, const size_t front, std::false_type);
+    void grow_back_if_needed(void);
+    void grow_front_if_needed(void);
+    void destroy_all(void);
 
    public:
     Dynamic_Array(void);
+    Dynamic_Array(const Dynamic_Array &to_copy);
+    Dynamic_Array(Dynamic_Array &&to_move);
     ~Dynamic_Array(void);
+    Dynamic_Array &operator=(const Dynamic_Array &to_copy);
+    Dynamic_Array &operator=(Dynamic_Array &&to_move);
     std::string to_string(void) const;
-    void push(const Number value);
+    size_t length(void) const { return len; }
+    size_t capacity(void) const { return _capacity; }
+    void reserve(const size_t capacity);
+    void shrink_to_fit(void);
+    Number *make_contiguous(void);
+    template <typename... Arguments>
+    Number &emplace_back(Arguments &&...arguments);
+    void push(const Number &value);
+    void push(Number &&value);
     Number pop(void);
-    void unshift(const Number value);
+    void unshift(const Number &value);
+    void unshift(Number &&value);
     Number shift(void);
     Number value_at(const size_t index) const;
-    size_t find(const Number value) const;
+    size_t find(const Number &value) const;
     void delete_at(const size_t index);
+    void erase(const size_t first, const size_t last);
+    template <typename Predicate>
+    size_t erase_if(Predicate predicate);
+    void swap_remove(const size_t index);
+    template <typename Iterator>
+    void insert(const size_t index, Iterator first, Iterator last);
+    template <typename Iterator>
+    void append(Iterator first, Iterator last);
     Number &operator[](const size_t index) const;
 
     // Iterators
-    Number *begin(void) { return &values[0]; }
-    const Number *begin(void) const { return &values[0]; }
-    Number *end(void) { return &values[length]; }
-    const Number *end(void) const { return &values[length]; }
+    Number *begin(void) { return values; }
+    const Number *begin(void) const { return values; }
+    Number *end(void) { return values + len; }
+    const Number *end(void) const { return values + len; }
 };
 
 template <typename Number>
-Dynamic_Array<Number>::Dynamic_Array(void) : length(0) {
-    capacity = initial_array_capacity;
-    values = new Number[capacity];
+Dynamic_Array<Number>::Dynamic_Array(void) : storage(nullptr), values(nullptr), _capacity(0), len(0) {
+    static_assert(alignof(Number) <= alignof(std::max_align_t), "Dynamic_Array allocates with malloc, which does not support over-aligned types");
+    relocate(initial_array_capacity, 0);
+}
+
+template <typename Number>
+Dynamic_Array<Number>::Dynamic_Array(const Dynamic_Array<Number> &to_copy) : Dynamic_Array() {
+    reserve(to_copy.len);
+    for (const Number &value : to_copy) {
+        new (values + len) Number(value);
+        len++;
+    }
+}
+
+template <typename Number>
+Dynamic_Array<Number>::Dynamic_Array(Dynamic_Array<Number> &&to_move) : storage(to_move.storage), values(to_move.values), _capacity(to_move._capacity), len(to_move.len) {
+    to_move.storage = nullptr;
+    to_move.values = nullptr;
+    to_move._capacity = 0;
+    to_move.len = 0;
 }
 
 template <typename Number>
 Dynamic_Array<Number>::~Dynamic_Array(void) {
-    length = 0;
-    capacity = 0;
-    delete[] values;
+    destroy_all();
+    std::free(storage);
+    storage = nullptr;
     values = nullptr;
+    _capacity = 0;
+}
+
+template <typename Number>
+Dynamic_Array<Number> &Dynamic_Array<Number>::operator=(const Dynamic_Array<Number> &to_copy) {
+    if (this != &to_copy) {
+        *this = Dynamic_Array<Number>(to_copy);
+    }
+    return *this;
+}
+
+template <typename Number>
+Dynamic_Array<Number> &Dynamic_Array<Number>::operator=(Dynamic_Array<Number> &&to_move) {
+    if (this != &to_move) {
+        destroy_all();
+        std::free(storage);
+        storage = to_move.storage;
+        values = to_move.values;
+        _capacity = to_move._capacity;
+        len = to_move.len;
+        to_move.storage = nullptr;
+        to_move.values = nullptr;
+        to_move._capacity = 0;
+        to_move.len = 0;
+    }
+    return *this;
 }
 
 template <typename Number>
@@ -79,77 +181,275 @@ std::ostream &operator<<(std::ostream &os, const Dynamic_Array<Number> &array) {
 template <typename Number>
 std::string Dynamic_Array<Number>::to_string(void) const {
     std::ostringstream strs;
-    strs << "Array length: " << length << ", capacity: " << capacity << std::endl;
-    for (size_t i = 0; i < length; i++) {
+    strs << "Array length: " << len << ", capacity: " << _capacity << std::endl;
+    for (size_t i = 0; i < len; i++) {
         strs << "[" << std::setw(3) << i << "]: " << values[i] << std::endl;
     }
     return strs.str();
 }
 
+// Raw storage for capacity elements, or nullptr for none
+template <typename Number>
+Number *Dynamic_Array<Number>::allocate(const size_t capacity) {
+    if (capacity == 0) {
+        return nullptr;
+    }
+    Number *memory = static_cast<Number *>(std::malloc(capacity * sizeof(Number)));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::destroy(Number *first, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        first[i].~Number();
+    }
+}
+
+// Constructs count elements on the raw destination from the source ones,
+// which are moved, or copied if their move constructor may throw. If a copy
+// throws, the elements already built are destroyed
+template <typename Number>
+void Dynamic_Array<Number>::construct_moved(Number *source, const size_t count, Number *destination) {
+    construct_moved(source, count, destination, trivially_copyable());
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::construct_moved(Number *source, const size_t count, Number *destination, std::true_type) {
+    if (count != 0) {
+        std::memcpy(static_cast<void *>(destination), static_cast<const void *>(source), count * sizeof(Number));
+    }
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::construct_moved(Number *source, const size_t count, Number *destination, std::false_type) {
+    size_t moved = 0;
+    try {
+        for (; moved < count; moved++) {
+            new (destination + moved) Number(std::move_if_noexcept(source[moved]));
+        }
+    } catch (...) {
+        destroy(destination, moved);
+        throw;
+    }
+}
+
+// Moves count elements over others of the array, in either direction,
+// with memmove for trivially copyable types
+template <typename Number>
+void Dynamic_Array<Number>::move_elements(Number *source, const size_t count, Number *destination) {
+    move_elements(source, count, destination, trivially_copyable());
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::move_elements(Number *source, const size_t count, Number *destination, std::true_type) {
+    if (count != 0) {
+        std::memmove(static_cast<void *>(destination), static_cast<const void *>(source), count * sizeof(Number));
+    }
+}
+
 template <typename Number>
-void Dynamic_Array<Number>::grow_capacity_if_needed(void) {
-    if (length + 1 > capacity) {
-        capacity *= 2;
-        Number *new_values = new Number[capacity];
-        std::copy(&values[0], &values[length], new_values);
-        delete[] values;
-        values = new_values;
+void Dynamic_Array<Number>::move_elements(Number *source, const size_t count, Number *destination, std::false_type) {
+    if (destination < source) {
+        std::move(source, source + count, destination);
+    } else {
+        std::move_backward(source, source + count, destination + count);
     }
 }
 
+// Places the elements at the given offset of a storage with the given
+// capacity, which is the current one when they only slide
+template <typename Number>
+void Dynamic_Array<Number>::relocate(const size_t capacity, const size_t front) {
+    relocate(capacity, front, trivially_copyable());
+}
+
 template <typename Number>
-void Dynamic_Array<Number>::push(const Number value) {
-    grow_capacity_if_needed();
-    values[length] = value;
-    length++;
+void Dynamic_Array<Number>::relocate(const size_t capacity, const size_t front, std::true_type) {
+    if (capacity == _capacity) {
+        move_elements(values, len, storage + front);
+    } else if (capacity == 0) {
+        std::free(storage);
+        storage = nullptr;
+    } else if ((front == 0) && (front_gap() == 0)) {
+        Number *new_storage = static_cast<Number *>(std::realloc(storage, capacity * sizeof(Number)));
+        if (new_storage == nullptr) {
+            throw std::bad_alloc();
+        }
+        storage = new_storage;
+    } else {
+        Number *new_storage = allocate(capacity);
+        construct_moved(values, len, new_storage + front);
+        std::free(storage);
+        storage = new_storage;
+    }
+    values = storage + front;
+    _capacity = capacity;
+}
+
+// Moves the elements to a new buffer, even when they only slide, since the
+// slots they leave and the ones they take would have to be told apart. If
+// a copy throws, the new buffer is released and the array is left as it was
+template <typename Number>
+void Dynamic_Array<Number>::relocate(const size_t capacity, const size_t front, std::false_type) {
+    Number *new_storage = allocate(capacity);
+    try {
+        construct_moved(values, len, new_storage + front);
+    } catch (...) {
+        std::free(new_storage);
+        throw;
+    }
+    const size_t moved = len;
+    destroy_all();
+    std::free(storage);
+    storage = new_storage;
+    values = new_storage + front;
+    len = moved;
+    _capacity = capacity;
+}
+
+// Makes room for one element at the back. If at least half of the storage
+// is the front gap, the elements slide to its start, otherwise the storage
+// doubles, without the gap
+template <typename Number>
+void Dynamic_Array<Number>::grow_back_if_needed(void) {
+    if (front_gap() + len + 1 > _capacity) {
+        if ((2 * front_gap() >= _capacity) && (front_gap() != 0)) {
+            relocate(_capacity, 0);
+        } else {
+            relocate(grown_capacity(), 0);
+        }
+    }
+}
+
+// Makes room for one element at the front. Half of the free space goes in
+// front of the elements, in the same storage if at least half of it is
+// free, or in one twice as large
+template <typename Number>
+void Dynamic_Array<Number>::grow_front_if_needed(void) {
+    if (front_gap() == 0) {
+        const size_t capacity = ((2 * len <= _capacity) && (len < _capacity)) ? _capacity : grown_capacity();
+        relocate(capacity, (capacity - len + 1) / 2);
+    }
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::destroy_all(void) {
+    destroy(values, len);
+    len = 0;
+}
+
+// Makes room for capacity elements, so that pushing up to that length
+// does not reallocate. Closes the front gap if needed
+template <typename Number>
+void Dynamic_Array<Number>::reserve(const size_t capacity) {
+    if (capacity > _capacity - front_gap()) {
+        relocate((capacity > _capacity) ? capacity : _capacity, 0);
+    }
+}
+
+// Releases the unused capacity, at both ends
+template <typename Number>
+void Dynamic_Array<Number>::shrink_to_fit(void) {
+    if (len < _capacity) {
+        relocate(len, 0);
+    }
+}
+
+// The elements are always contiguous, from begin() to end(). This closes
+// the front gap too, so the storage starts with them and all of the spare
+// capacity is at the back, and returns the first one
+template <typename Number>
+Number *Dynamic_Array<Number>::make_contiguous(void) {
+    if (front_gap() != 0) {
+        relocate(_capacity, 0);
+    }
+    return values;
+}
+
+// Constructs the new element in place from the arguments. When the array
+// has to grow, the element is built before, since the arguments may refer
+// to elements of the array itself
+template <typename Number>
+template <typename... Arguments>
+Number &Dynamic_Array<Number>::emplace_back(Arguments &&...arguments) {
+    if (front_gap() + len + 1 > _capacity) {
+        Number value(std::forward<Arguments>(arguments)...);
+        grow_back_if_needed();
+        new (values + len) Number(std::move(value));
+    } else {
+        new (values + len) Number(std::forward<Arguments>(arguments)...);
+    }
+    len++;
+    return values[len - 1];
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::push(const Number &value) {
+    emplace_back(value);
+}
+
+template <typename Number>
+void Dynamic_Array<Number>::push(Number &&value) {
+    emplace_back(std::move(value));
 }
 
 template <typename Number>
 Number Dynamic_Array<Number>::pop(void) {
-    if (length == 0) {
+    if (len == 0) {
         throw std::runtime_error("Trying to pop an empty array!");
     }
-    length--;
-    return values[length];
+    len--;
+    Number value(std::move(values[len]));
+    values[len].~Number();
+    return value;
 }
 
 // Inserts element at the beginning of the array
 template <typename Number>
-void Dynamic_Array<Number>::unshift(const Number value) {
-    grow_capacity_if_needed();
-    for (size_t i = length; i > 0; i--) {
-        values[i] = values[i - 1];
-    }
-    values[0] = value;
-    length++;
+void Dynamic_Array<Number>::unshift(const Number &value) {
+    unshift(Number(value));
 }
 
-// Removes and returns first element of the array
+template <typename Number>
+void Dynamic_Array<Number>::unshift(Number &&value) {
+    grow_front_if_needed();
+    new (values - 1) Number(std::move(value));
+    values--;
+    len++;
+}
+
+// Removes and returns first element of the array. An empty array moves its
+// start back to the beginning of the storage
 template <typename Number>
 Number Dynamic_Array<Number>::shift(void) {
-    if (length == 0) {
+    if (len == 0) {
         throw std::runtime_error("Trying to shift an empty array!");
     }
-    const Number value = values[0];
-    length--;
-    for (size_t i = 0; i < length; i++) {
-        values[i] = values[i + 1];
+    Number value(std::move(values[0]));
+    values[0].~Number();
+    values++;
+    len--;
+    if (len == 0) {
+        values = storage;
     }
     return value;
 }
 
 template <typename Number>
 Number Dynamic_Array<Number>::value_at(const size_t index) const {
-    if (index >= length) {
+    if (index >= len) {
         throw std::runtime_error("Trying to access the array in invalid range!");
     }
     return values[index];
 }
 
 template <typename Number>
-size_t Dynamic_Array<Number>::find(const Number value) const {
+size_t Dynamic_Array<Number>::find(const Number &value) const {
     // Sequential search
-    for (size_t i = 0; i < length; i++) {
+    for (size_t i = 0; i < len; i++) {
         if (values[i] == value) {
             return i;
         }
@@ -159,18 +459,143 @@ size_t Dynamic_Array<Number>::find(const Number value) const {
 
 template <typename Number>
 void Dynamic_Array<Number>::delete_at(const size_t index) {
-    if (index >= length) {
+    if (index >= len) {
         throw std::runtime_error("Trying to delete an element from the array in invalid range!");
     }
-    length--;
-    for (size_t i = index; i < length; i++) {
-        values[i] = values[i + 1];
+    erase(index, index + 1);
+}
+
+// Removes the elements from first up to last, not included, closing the
+// hole from the nearest end, so that removing from the front is as cheap
+// as removing from the back
+template <typename Number>
+void Dynamic_Array<Number>::erase(const size_t first, const size_t last) {
+    if ((first > last) || (last > len)) {
+        throw std::runtime_error("Trying to erase elements from the array in invalid range!");
+    }
+    const size_t count = last - first;
+    if (count == 0) {
+        return;
+    }
+    if (first < len - last) {
+        move_elements(values, first, values + count);
+        destroy(values, count);
+        values += count;
+    } else {
+        move_elements(values + last, len - last, values + first);
+        destroy(values + len - count, count);
+    }
+    len -= count;
+    if (len == 0) {
+        values = storage;
+    }
+}
+
+// Removes the elements for which the predicate is true, keeping the order
+// of the others, in a single pass. Returns how many were removed
+template <typename Number>
+template <typename Predicate>
+size_t Dynamic_Array<Number>::erase_if(Predicate predicate) {
+    size_t kept = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!predicate(values[i])) {
+            if (kept != i) {
+                values[kept] = std::move(values[i]);
+            }
+            kept++;
+        }
+    }
+    const size_t removed = len - kept;
+    destroy(values + kept, removed);
+    len = kept;
+    if (len == 0) {
+        values = storage;
+    }
+    return removed;
+}
+
+// Removes an element in O(1), moving the last one to its place, so the
+// order is not kept
+template <typename Number>
+void Dynamic_Array<Number>::swap_remove(const size_t index) {
+    if (index >= len) {
+        throw std::runtime_error("Trying to delete an element from the array in invalid range!");
+    }
+    if (index != len - 1) {
+        values[index] = std::move(values[len - 1]);
+    }
+    len--;
+    values[len].~Number();
+    if (len == 0) {
+        values = storage;
+    }
+}
+
+// Inserts copies of the elements from first up to last before the given
+// index, growing the array at most once. With room left, they are built
+// at the end and rotated into place. Otherwise a new storage is built
+// around them, and they are copied first, so the range may come from the
+// array itself
+template <typename Number>
+template <typename Iterator>
+void Dynamic_Array<Number>::insert(const size_t index, Iterator first, Iterator last) {
+    if (index > len) {
+        throw std::runtime_error("Trying to insert elements into the array in invalid range!");
     }
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if (front_gap() + len + count <= _capacity) {
+        const size_t previous_length = len;
+        try {
+            for (; first != last; ++first) {
+                new (values + len) Number(*first);
+                len++;
+            }
+        } catch (...) {
+            destroy(values + previous_length, len - previous_length);
+            len = previous_length;
+            throw;
+        }
+        std::rotate(values + index, values + previous_length, values + len);
+        return;
+    }
+    const size_t capacity = (grown_capacity() > len + count) ? grown_capacity() : len + count;
+    Number *new_storage = allocate(capacity);
+    size_t built = 0;
+    try {
+        for (; first != last; ++first) {
+            new (new_storage + index + built) Number(*first);
+            built++;
+        }
+        construct_moved(values, index, new_storage);
+        try {
+            construct_moved(values + index, len - index, new_storage + index + count);
+        } catch (...) {
+            destroy(new_storage, index);
+            throw;
+        }
+    } catch (...) {
+        destroy(new_storage + index, built);
+        std::free(new_storage);
+        throw;
+    }
+    const size_t new_length = len + count;
+    destroy_all();
+    std::free(storage);
+    storage = new_storage;
+    values = new_storage;
+    len = new_length;
+    _capacity = capacity;
+}
+
+template <typename Number>
+template <typename Iterator>
+void Dynamic_Array<Number>::append(Iterator first, Iterator last) {
+    insert(len, first, last);
 }
 
 template <typename Number>
 Number &Dynamic_Array<Number>::operator[](const size_t index) const {
-    if (index >= length) {
+    if (index >= len) {
         throw std::runtime_error("Trying to access dynamic array in invalid range!");
     }
     return values[index];
@@ -0,0 +1,490 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __FFT_CPP
+#define __FFT_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "complex.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "scalar.hpp"
+
+// Resolution of the sine table of the twiddle factors, in steps of a
+// quarter turn
+constexpr size_t fft_sine_table_length = 1 << 12;
+
+// Returns exp(-2*pi*i*k/n). The angle is reduced to the first octant, in
+// double precision, and the symmetries of sine and cosine give the other
+// octants exactly, so the table is symmetric to the last bit. Angles which
+// fall on the compile-time sine table are looked up, which covers every
+// power of two up to 4 * fft_sine_table_length
+template <typename Floating>
+Complex<Floating> twiddle_factor(const size_t k, const size_t n) {
+    const size_t quadrant = ((4 * (k % n)) / n) % 4;
+    size_t remainder = 4 * (k % n) - quadrant * n;
+    const bool complement = (2 * remainder > n);
+    if (complement) {
+        remainder = n - remainder;
+    }
+    double sine_value, cosine_value;
+    if ((remainder * fft_sine_table_length) % n == 0) {
+        const size_t index = remainder * fft_sine_table_length / n;
+        sine_value = Sine_Table<fft_sine_table_length>::sine[index];
+        cosine_value = Sine_Table<fft_sine_table_length>::cosine[index];
+    } else {
+        const double phase = (const_pi / 2.0) * static_cast<double>(remainder) / static_cast<double>(n);
+        sincos(phase, sine_value, cosine_value);
+    }
+    const Floating c = static_cast<Floating>(complement ? sine_value : cosine_value);
+    const Floating s = static_cast<Floating>(complement ? cosine_value : sine_value);
+    switch (quadrant) {
+        case 0:
+            return Complex<Floating>(c, -s);
+        case 1:
+            return Complex<Floating>(-s, -c);
+        case 2:
+            return Complex<Floating>(-c, s);
+        default:
+            return Complex<Floating>(s, c);
+    }
+}
+
+// Multiplies by -i in the forward transform and by +i in the inverse one
+template <bool inverse, typename Floating>
+Complex<Floating> rotate_quarter(const Complex<Floating> value) {
+    return inverse ? Complex<Floating>(-value.imag_part(), value.real_part()) : Complex<Floating>(value.imag_part(), -value.real_part());
+}
+
+// Plans hold everything which depends only on the length of the transform:
+// the bit reversal permutation and contiguous twiddle factors for each
+// stage. Powers of two run an iterative radix-4 kernel, with one radix-2
+// stage when the number of bits is odd. Other lengths use Bluestein's
+// algorithm, which turns the transform in a circular convolution of a
+// power of two length. Plans are read only after construction, so the
+// same plan can be used by several threads at once.
+template <typename Floating>
+class FFT_Plan {
+   private:
+    size_t len;
+    size_t bits;
+    std::vector<uint32_t> reversed;
+    std::vector<Complex<Floating>> twiddles;
+    // Used only by Bluestein's algorithm
+    std::unique_ptr<FFT_Plan> convolution;
+    std::vector<Complex<Floating>> chirp;
+    std::vector<Complex<Floating>> chirp_transform;
+
+    template <bool inverse>
+    void radix(Complex<Floating> *data) const;
+    template <bool inverse>
+    void bluestein(Complex<Floating> *data) const;
+
+   public:
+    explicit FFT_Plan(const size_t length);
+    size_t length(void) const;
+    void forward(Complex<Floating> *data) const;
+    void inverse(Complex<Floating> *data) const;
+    void forward(std::vector<Complex<Floating>> &data) const;
+    void inverse(std::vector<Complex<Floating>> &data) const;
+};
+
+bool is_power_of_two(const size_t value) {
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+size_t next_power_of_two(const size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power *= 2;
+    }
+    return power;
+}
+
+template <typename Floating>
+FFT_Plan<Floating>::FFT_Plan(const size_t length) : len(length), bits(0) {
+    if (length == 0) {
+        throw std::runtime_error("Trying to create a FFT plan of length zero!");
+    }
+    if (!is_power_of_two(length)) {
+        // The chirp exp(-pi*i*k^2/n) has period 2n in k^2
+        const size_t m = next_power_of_two(2 * length - 1);
+        convolution.reset(new FFT_Plan(m));
+        chirp.resize(length);
+        chirp_transform.assign(m, Complex<Floating>());
+        for (size_t k = 0; k < length; k++) {
+            const size_t square = static_cast<size_t>((static_cast<uint64_t>(k) * k) % (2 * length));
+            chirp[k] = twiddle_factor<Floating>(square, 2 * length);
+            chirp_transform[k] = chirp[k].conjugate();
+            if (k != 0) {
+                chirp_transform[m - k] = chirp[k].conjugate();
+            }
+        }
+        convolution->forward(chirp_transform.data());
+        return;
+    }
+    if (length > (static_cast<size_t>(1) << 32)) {
+        throw std::runtime_error("Trying to create a FFT plan with more than 2^32 points!");
+    }
+    while ((static_cast<size_t>(1) << bits) < length) {
+        bits++;
+    }
+    reversed.resize(length);
+    reversed[0] = 0;
+    for (size_t i = 1; i < length; i++) {
+        reversed[i] = static_cast<uint32_t>((reversed[i >> 1] >> 1) | ((i & 1) << (bits - 1)));
+    }
+    // Every radix-4 stage of blocks with 4*q points needs W^j, W^2j and
+    // W^3j for j < q, where W = exp(-2*pi*i/(4*q)). They are stored side
+    // by side, in the order the kernel reads them. All these values are
+    // powers of exp(-2*pi*i/length), which are evaluated once
+    std::vector<Complex<Floating>> roots(length);
+    parallel_for(length, [&](const size_t begin, const size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            roots[k] = twiddle_factor<Floating>(k, length);
+        }
+    });
+    for (size_t q = (bits % 2) ? 2 : 1; 4 * q <= length; q *= 4) {
+        const size_t stride = length / (4 * q);
+        for (size_t j = 0; j < q; j++) {
+            twiddles.push_back(roots[j * stride]);
+            twiddles.push_back(roots[2 * j * stride]);
+            twiddles.push_back(roots[3 * j * stride]);
+        }
+    }
+}
+
+template <typename Floating>
+size_t FFT_Plan<Floating>::length(void) const {
+    return len;
+}
+
+template <typename Floating>
+template <bool inverse>
+void FFT_Plan<Floating>::radix(Complex<Floating> *data) const {
+    for (size_t i = 0; i < len; i++) {
+        if (i < reversed[i]) {
+            swap(data[i], data[reversed[i]]);
+        }
+    }
+    size_t q = 1;
+    if (bits % 2) {
+        for (size_t k = 0; k < len; k += 2) {
+            const Complex<Floating> a = data[k];
+            const Complex<Floating> b = data[k + 1];
+            data[k] = a + b;
+            data[k + 1] = a - b;
+        }
+        q = 2;
+    }
+    const Complex<Floating> *w = twiddles.data();
+    for (; 4 * q <= len; q *= 4) {
+        for (size_t k = 0; k < len; k += 4 * q) {
+            Complex<Floating> *const x = data + k;
+            for (size_t j = 0; j < q; j++) {
+                const Complex<Floating> w1 = inverse ? w[3 * j].conjugate() : w[3 * j];
+                const Complex<Floating> w2 = inverse ? w[3 * j + 1].conjugate() : w[3 * j + 1];
+                const Complex<Floating> w3 = inverse ? w[3 * j + 2].conjugate() : w[3 * j + 2];
+                const Complex<Floating> a0 = x[j];
+                const Complex<Floating> a1 = x[j + q] * w2;
+                const Complex<Floating> a2 = x[j + 2 * q] * w1;
+                const Complex<Floating> a3 = x[j + 3 * q] * w3;
+                const Complex<Floating> sum = a0 + a1;
+                const Complex<Floating> difference = a0 - a1;
+                const Complex<Floating> odd_sum = a2 + a3;
+                const Complex<Floating> odd_difference = rotate_quarter<inverse>(a2 - a3);
+                x[j] = sum + odd_sum;
+                x[j + q] = difference + odd_difference;
+                x[j + 2 * q] = sum - odd_sum;
+                x[j + 3 * q] = difference - odd_difference;
+            }
+        }
+        w += 3 * q;
+    }
+}
+
+template <typename Floating>
+template <bool inverse>
+void FFT_Plan<Floating>::bluestein(Complex<Floating> *data) const {
+    const size_t m = convolution->length();
+    std::vector<Complex<Floating>> buffer(m);
+    for (size_t k = 0; k < len; k++) {
+        buffer[k] = (inverse ? data[k].conjugate() : data[k]) * chirp[k];
+    }
+    convolution->forward(buffer.data());
+    for (size_t k = 0; k < m; k++) {
+        buffer[k] = buffer[k] * chirp_transform[k];
+    }
+    convolution->inverse(buffer.data());
+    for (size_t k = 0; k < len; k++) {
+        const Complex<Floating> value = buffer[k] * chirp[k];
+        data[k] = inverse ? value.conjugate() : value;
+    }
+}
+
+// Unnormalized transform: X[k] = sum(x[n] * exp(-2*pi*i*k*n/length))
+template <typename Floating>
+void FFT_Plan<Floating>::forward(Complex<Floating> *data) const {
+    if (convolution) {
+        bluestein<false>(data);
+    } else {
+        radix<false>(data);
+    }
+}
+
+// Inverse transform, scaled by 1/length, so it undoes forward
+template <typename Floating>
+void FFT_Plan<Floating>::inverse(Complex<Floating> *data) const {
+    if (convolution) {
+        bluestein<true>(data);
+    } else {
+        radix<true>(data);
+    }
+    const Floating scale = static_cast<Floating>(1.0 / static_cast<double>(len));
+    for (size_t k = 0; k < len; k++) {
+        data[k] = data[k] * scale;
+    }
+}
+
+template <typename Floating>
+void FFT_Plan<Floating>::forward(std::vector<Complex<Floating>> &data) const {
+    if (data.size() != len) {
+        throw std::runtime_error("Trying to transform data with a plan of a different length!");
+    }
+    forward(data.data());
+}
+
+template <typename Floating>
+void FFT_Plan<Floating>::inverse(std::vector<Complex<Floating>> &data) const {
+    if (data.size() != len) {
+        throw std::runtime_error("Trying to transform data with a plan of a different length!");
+    }
+    inverse(data.data());
+}
+
+// Transform of real signals, which have Hermitian spectra: X[length - k] is
+// conjugate(X[k]), so only the length/2 + 1 first bins are computed. For
+// even lengths, the samples are packed in pairs as z[n] = x[2n] + i*x[2n+1]
+// and a complex FFT of half the length is unpacked with the twiddles
+// exp(-2*pi*i*k/length), which halves the work. Odd lengths fall back to a
+// complex transform of the full length.
+template <typename Floating>
+class Real_FFT_Plan {
+   private:
+    size_t len;
+    FFT_Plan<Floating> plan;
+    std::vector<Complex<Floating>> twiddles;
+
+   public:
+    explicit Real_FFT_Plan(const size_t length);
+    size_t length(void) const { return len; }
+    size_t spectrum_length(void) const { return len / 2 + 1; }
+    void forward(const Floating *input, Complex<Floating> *spectrum) const;
+    void inverse(Complex<Floating> *spectrum, Floating *output) const;
+};
+
+template <typename Floating>
+Real_FFT_Plan<Floating>::Real_FFT_Plan(const size_t length) : len(length), plan((length % 2) ? length : length / 2) {
+    if (length % 2 == 0) {
+        twiddles.reserve(length / 2 + 1);
+        for (size_t k = 0; k <= length / 2; k++) {
+            twiddles.push_back(twiddle_factor<Floating>(k, length));
+        }
+    }
+}
+
+// Writes spectrum_length() bins
+template <typename Floating>
+void Real_FFT_Plan<Floating>::forward(const Floating *input, Complex<Floating> *spectrum) const {
+    if (len % 2) {
+        std::vector<Complex<Floating>> buffer(len);
+        for (size_t n = 0; n < len; n++) {
+            buffer[n] = Complex<Floating>(input[n]);
+        }
+        plan.forward(buffer.data());
+        std::copy(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(spectrum_length()), spectrum);
+        return;
+    }
+    const size_t half = len / 2;
+    for (size_t n = 0; n < half; n++) {
+        spectrum[n] = Complex<Floating>(input[2 * n], input[2 * n + 1]);
+    }
+    plan.forward(spectrum);
+    const Floating one_half = static_cast<Floating>(0.5);
+    const Complex<Floating> first = spectrum[0];
+    spectrum[0] = Complex<Floating>(first.real_part() + first.imag_part());
+    spectrum[half] = Complex<Floating>(first.real_part() - first.imag_part());
+    // Bins k and half - k are built from the same pair of values
+    for (size_t k = 1; 2 * k <= half; k++) {
+        const size_t j = half - k;
+        const Complex<Floating> a = spectrum[k];
+        const Complex<Floating> b = spectrum[j];
+        const Complex<Floating> even = (a + b.conjugate()) * one_half;
+        const Complex<Floating> odd = rotate_quarter<false>(a - b.conjugate()) * one_half;
+        spectrum[k] = even + twiddles[k] * odd;
+        spectrum[j] = even.conjugate() + twiddles[j] * odd.conjugate();
+    }
+}
+
+// Reads spectrum_length() bins and writes length() samples, scaled so it
+// undoes forward. The spectrum is used as workspace, so it is overwritten
+template <typename Floating>
+void Real_FFT_Plan<Floating>::inverse(Complex<Floating> *spectrum, Floating *output) const {
+    if (len % 2) {
+        std::vector<Complex<Floating>> buffer(len);
+        for (size_t k = 0; k < len; k++) {
+            buffer[k] = (k < spectrum_length()) ? spectrum[k] : spectrum[len - k].conjugate();
+        }
+        plan.inverse(buffer.data());
+        for (size_t n = 0; n < len; n++) {
+            output[n] = buffer[n].real_part();
+        }
+        return;
+    }
+    const size_t half = len / 2;
+    const Floating one_half = static_cast<Floating>(0.5);
+    const Floating first = spectrum[0].real_part();
+    const Floating last = spectrum[half].real_part();
+    spectrum[0] = Complex<Floating>((first + last) * one_half, (first - last) * one_half);
+    for (size_t k = 1; 2 * k <= half; k++) {
+        const size_t j = half - k;
+        const Complex<Floating> a = spectrum[k];
+        const Complex<Floating> b = spectrum[j];
+        const Complex<Floating> even = (a + b.conjugate()) * one_half;
+        const Complex<Floating> odd = (a - b.conjugate()) * twiddles[k].conjugate() * one_half;
+        const Complex<Floating> odd_pair = (b - a.conjugate()) * twiddles[j].conjugate() * one_half;
+        spectrum[k] = even + rotate_quarter<true>(odd);
+        spectrum[j] = even.conjugate() + rotate_quarter<true>(odd_pair);
+    }
+    plan.inverse(spectrum);
+    for (size_t n = 0; n < half; n++) {
+        output[2 * n] = spectrum[n].real_part();
+        output[2 * n + 1] = spectrum[n].imag_part();
+    }
+}
+
+// Tasks of the 2D transform get whole rows, at least fft_2d_task_points
+// points each, so short rows don't cost a task each
+constexpr size_t fft_2d_task_points = 1 << 12;
+
+// Transform of a rows x cols matrix: the FFTs of all rows, then of all
+// columns. The columns are not transformed in place, since walking down a
+// column touches a new cache line per element. Instead, the matrix is
+// transposed by tiles, its rows are transformed and it is transposed back.
+// Rows are distributed over the threads of pool, or of parallel_pool()
+// when it is nullptr.
+template <typename Floating>
+class FFT_2D_Plan {
+   private:
+    FFT_Plan<Floating> row_plan;
+    FFT_Plan<Floating> col_plan;
+    Thread_Pool *pool;
+
+    template <bool inverse>
+    void transform(Matrix<Complex<Floating>> &matrix) const;
+    template <bool inverse>
+    void transform_rows(Complex<Floating> *data, const FFT_Plan<Floating> &plan, const size_t rows, Thread_Pool &threads) const;
+
+   public:
+    explicit FFT_2D_Plan(const size_t rows, const size_t cols, Thread_Pool *pool = nullptr) : row_plan(cols), col_plan(rows), pool(pool) {}
+    size_t rows(void) const { return col_plan.length(); }
+    size_t cols(void) const { return row_plan.length(); }
+    void forward(Matrix<Complex<Floating>> &matrix) const;
+    void inverse(Matrix<Complex<Floating>> &matrix) const;
+};
+
+template <typename Floating>
+template <bool inverse>
+void FFT_2D_Plan<Floating>::transform_rows(Complex<Floating> *data, const FFT_Plan<Floating> &plan, const size_t rows, Thread_Pool &threads) const {
+    const size_t length = plan.length();
+    const size_t rows_per_task = maximum<size_t>(fft_2d_task_points / length, 1);
+    threads.run((rows + rows_per_task - 1) / rows_per_task, [&](const size_t task) {
+        const size_t end = minimum(rows, (task + 1) * rows_per_task);
+        for (size_t row = task * rows_per_task; row < end; row++) {
+            if (inverse) {
+                plan.inverse(data + row * length);
+            } else {
+                plan.forward(data + row * length);
+            }
+        }
+    });
+}
+
+template <typename Floating>
+template <bool inverse>
+void FFT_2D_Plan<Floating>::transform(Matrix<Complex<Floating>> &matrix) const {
+    if ((matrix.rows() != rows()) || (matrix.cols() != cols())) {
+        throw std::runtime_error("Trying to transform a matrix with a plan of a different size!");
+    }
+    Thread_Pool &threads = (pool != nullptr) ? *pool : parallel_pool();
+    Matrix<Complex<Floating>> transposed(cols(), rows());
+    transform_rows<inverse>(matrix.begin(), row_plan, rows(), threads);
+    transpose_blocked(matrix.begin(), rows(), cols(), transposed.begin(), threads);
+    transform_rows<inverse>(transposed.begin(), col_plan, cols(), threads);
+    transpose_blocked(transposed.begin(), cols(), rows(), matrix.begin(), threads);
+}
+
+template <typename Floating>
+void FFT_2D_Plan<Floating>::forward(Matrix<Complex<Floating>> &matrix) const {
+    transform<false>(matrix);
+}
+
+// Scaled by 1/(rows * cols), so it undoes forward
+template <typename Floating>
+void FFT_2D_Plan<Floating>::inverse(Matrix<Complex<Floating>> &matrix) const {
+    transform<true>(matrix);
+}
+
+#endif  // __FFT_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,308 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __HALF_CPP
+#define __HALF_CPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "matrix.hpp"
+#include "scalar.hpp"
+#include "vector.hpp"
+
+// Number of 16-bit values converted to float at once by the kernels
+constexpr size_t half_block_length = 256;
+
+uint32_t float_bits(const float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bits_float(const uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// IEEE 754 binary16: 1 sign bit, 5 exponent bits and 10 mantissa bits.
+// It is only a storage format: the arithmetic is done in float
+class Half {
+   private:
+    uint16_t bits;
+
+   public:
+    Half(void) : bits(0) {}
+    explicit Half(const float value);
+    operator float(void) const;
+    uint16_t raw(void) const { return bits; }
+    static Half from_raw(const uint16_t bits);
+};
+
+Half Half::from_raw(const uint16_t bits) {
+    Half half;
+    half.bits = bits;
+    return half;
+}
+
+// Rounds to nearest even, keeping subnormals, infinities and NaNs. The
+// software version follows the float to half conversion of Fabian Giesen
+Half::Half(const float value) {
+#if defined(__F16C__)
+    bits = static_cast<uint16_t>(_cvtss_sh(value, 0));
+#else
+    uint32_t x = float_bits(value);
+    const uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+    if (x >= (143u << 23)) {
+        // Overflows to infinity, or is already infinity or NaN
+        bits = (x > 0x7f800000u) ? 0x7e00 : 0x7c00;
+    } else if (x < (113u << 23)) {
+        // Subnormal or zero: the float addition does the rounding
+        const uint32_t magic = 126u << 23;
+        x = float_bits(bits_float(x) + bits_float(magic)) - magic;
+        bits = static_cast<uint16_t>(x);
+    } else {
+        const uint32_t odd_mantissa = (x >> 13) & 1;
+        x = x - (112u << 23) + 0xfff + odd_mantissa;
+        bits = static_cast<uint16_t>(x >> 13);
+    }
+    bits = static_cast<uint16_t>(bits | (sign >> 16));
+#endif
+}
+
+Half::operator float(void) const {
+#if defined(__F16C__)
+    return _cvtsh_ss(bits);
+#else
+    const uint32_t shifted_exponent = 0x7c00u << 13;
+    uint32_t x = (bits & 0x7fffu) << 13;
+    const uint32_t exponent = x & shifted_exponent;
+    x += (127u - 15u) << 23;
+    if (exponent == shifted_exponent) {
+        // Infinity or NaN
+        x += (128u - 16u) << 23;
+    } else if (exponent == 0) {
+        // Zero or subnormal, renormalized by a float subtraction
+        x += 1u << 23;
+        x = float_bits(bits_float(x) - bits_float(113u << 23));
+    }
+    return bits_float(x | ((bits & 0x8000u) << 16));
+#endif
+}
+
+// Brain floating point: the upper half of a float, with 8 exponent bits
+// and 7 mantissa bits. It has the range of float with less precision
+class BFloat16 {
+   private:
+    uint16_t bits;
+
+   public:
+    BFloat16(void) : bits(0) {}
+    explicit BFloat16(const float value);
+    operator float(void) const { return bits_float(static_cast<uint32_t>(bits) << 16); }
+    uint16_t raw(void) const { return bits; }
+    static BFloat16 from_raw(const uint16_t bits);
+};
+
+BFloat16 BFloat16::from_raw(const uint16_t bits) {
+    BFloat16 bf16;
+    bf16.bits = bits;
+    return bf16;
+}
+
+// Rounds to nearest even. NaNs are kept quiet, since the rounding could
+// carry their mantissa into the exponent
+BFloat16::BFloat16(const float value) {
+    const uint32_t x = float_bits(value);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+        bits = static_cast<uint16_t>((x >> 16) | 0x40);
+    } else {
+        bits = static_cast<uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+    }
+}
+
+// Converts length values to float, 8 at a time when the instruction set
+// allows it
+template <typename Storage>
+void to_float(const Storage *input, float *output, const size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        output[i] = static_cast<float>(input[i]);
+    }
+}
+
+#if defined(__F16C__) && defined(__AVX__)
+template <>
+void to_float<Half>(const Half *input, float *output, const size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(half));
+    }
+    for (; i < length; i++) {
+        output[i] = static_cast<float>(input[i]);
+    }
+}
+#endif
+
+#if defined(__AVX2__)
+template <>
+void to_float<BFloat16>(const BFloat16 *input, float *output, const size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        const __m128i bf16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+        const __m256i widened = _mm256_slli_epi32(_mm256_cvtepu16_epi32(bf16), 16);
+        _mm256_storeu_ps(output + i, _mm256_castsi256_ps(widened));
+    }
+    for (; i < length; i++) {
+        output[i] = static_cast<float>(input[i]);
+    }
+}
+#endif
+
+template <typename To, typename From>
+Matrix<To> convert(const Matrix<From> &matrix) {
+    Matrix<To> result(matrix.rows(), matrix.cols());
+    const From *input = matrix.begin();
+    To *output = result.begin();
+    for (size_t i = 0; i < matrix.rows() * matrix.cols(); i++) {
+        output[i] = static_cast<To>(static_cast<float>(input[i]));
+    }
+    return result;
+}
+
+// Eight independent partial sums, which the compiler can keep in a
+// single SIMD register instead of waiting on one long addition chain
+float dot_product(const float *a, const float *b, const size_t length) {
+    float partial[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        for (size_t j = 0; j < 8; j++) {
+            partial[j] += a[i + j] * b[i + j];
+        }
+    }
+    float sum = 0.0f;
+    for (; i < length; i++) {
+        sum += a[i] * b[i];
+    }
+    for (size_t j = 0; j < 8; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+// Matrix-vector product with 16-bit (or float) storage. Each row is
+// converted to float one block at a time and accumulated in float
+template <typename Storage>
+Vector<float> gemv(const Matrix<Storage> &matrix, const Vector<float> &vector) {
+    if (matrix.cols() != vector.length()) {
+        throw std::runtime_error("Multiplication of matrix and vector with incompatible lengths!");
+    }
+    const size_t rows = matrix.rows();
+    const size_t cols = matrix.cols();
+    Vector<float> result(rows);
+    const Storage *a = matrix.begin();
+    const float *x = vector.begin();
+    float buffer[half_block_length];
+    for (size_t i = 0; i < rows; i++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < cols; k += half_block_length) {
+            const size_t length = minimum(half_block_length, cols - k);
+            to_float(a + i * cols + k, buffer, length);
+            sum += dot_product(buffer, x + k, length);
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+// Matrix product with 16-bit (or float) storage, accumulated in float. A
+// panel of rows of b is converted once and reused for every row of a
+template <typename Storage>
+Matrix<float> gemm(const Matrix<Storage> &a, const Matrix<Storage> &b) {
+    if (a.cols() != b.rows()) {
+        throw std::runtime_error("Trying to multiply matrices with incompatible sizes!");
+    }
+    const size_t rows = a.rows();
+    const size_t inner = a.cols();
+    const size_t cols = b.cols();
+    Matrix<float> result(rows, cols);
+    result = 0.0f;
+    if ((rows == 0) || (inner == 0) || (cols == 0)) {
+        return result;
+    }
+    // About 256 kB of converted values per panel
+    const size_t panel_rows = maximum<size_t>(1, (1 << 16) / cols);
+    std::unique_ptr<float[]> panel(new float[panel_rows * cols]);
+    std::unique_ptr<float[]> row(new float[panel_rows]);
+    float *c = result.begin();
+    for (size_t k0 = 0; k0 < inner; k0 += panel_rows) {
+        const size_t depth = minimum(panel_rows, inner - k0);
+        to_float(b.begin() + k0 * cols, panel.get(), depth * cols);
+        for (size_t i = 0; i < rows; i++) {
+            to_float(a.begin() + i * inner + k0, row.get(), depth);
+            float *c_row = c + i * cols;
+            for (size_t k = 0; k < depth; k++) {
+                const float scale = row[k];
+                const float *b_row = panel.get() + k * cols;
+                for (size_t j = 0; j < cols; j++) {
+                    c_row[j] += scale * b_row[j];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+#endif  // __HALF_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
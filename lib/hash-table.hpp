@@ -0,0 +1,542 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __HASH_TABLE_CPP
+#define __HASH_TABLE_CPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "random.hpp"
+
+// Number of control bytes compared at once
+constexpr size_t hash_group_width = 16;
+constexpr size_t initial_hash_capacity = 16;
+constexpr uint8_t hash_empty = 0x80;
+
+// Element of Hash_Map, whose key can not be changed, as it decides where
+// the element is stored
+template <typename Key, typename Value>
+struct Hash_Entry {
+    typedef Value Value_Type;
+    const Key key;
+    Value value;
+
+    template <typename... Arguments>
+    Hash_Entry(const Key &key, Arguments &&...arguments) : key(key), value(std::forward<Arguments>(arguments)...) {}
+};
+
+template <typename Key, typename Value>
+std::ostream &operator<<(std::ostream &os, const Hash_Entry<Key, Value> &entry) {
+    return os << entry.key << ": " << entry.value;
+}
+
+template <typename Key>
+const Key &hash_element_key(const Key &key) {
+    return key;
+}
+
+template <typename Key, typename Value>
+const Key &hash_element_key(const Hash_Entry<Key, Value> &entry) {
+    return entry.key;
+}
+
+// Integers are hashed by value, and floating point numbers by their bits
+template <typename Key>
+uint64_t hash_key_bits(const Key key, std::false_type) {
+    return static_cast<uint64_t>(key);
+}
+
+template <typename Key>
+uint64_t hash_key_bits(const Key key, std::true_type) {
+    // -0.0 equals 0.0, so both need the same bits
+    const Key normalized = (key == 0) ? 0 : key;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &normalized, sizeof(Key));
+    return bits;
+}
+
+// Mixes the bits of the key with SplitMix64, so that the low bits, which
+// select the slot, and the high bits, which are kept in the control byte,
+// depend on the whole key
+template <typename Key>
+uint64_t hash_key(const Key key) {
+    uint64_t state = hash_key_bits(key, std::integral_constant<bool, std::is_floating_point<Key>::value>());
+    return splitmix64(state);
+}
+
+// Bit i is set if the control byte i of the group equals tag, or is empty
+#if defined(__SSE2__)
+
+uint32_t hash_group_matches(const uint8_t *group, const uint8_t tag) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(tag)))));
+}
+
+uint32_t hash_group_empties(const uint8_t *group) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+}
+
+#else
+
+uint32_t hash_group_matches(const uint8_t *group, const uint8_t tag) {
+    uint32_t matches = 0;
+    for (size_t i = 0; i < hash_group_width; i++) {
+        matches |= static_cast<uint32_t>(group[i] == tag) << i;
+    }
+    return matches;
+}
+
+uint32_t hash_group_empties(const uint8_t *group) {
+    uint32_t empties = 0;
+    for (size_t i = 0; i < hash_group_width; i++) {
+        empties |= static_cast<uint32_t>(group[i] >> 7) << i;
+    }
+    return empties;
+}
+
+#endif
+
+// Flat hash table with linear probing, which stores the elements in one
+// array, next to an array of control bytes. A control byte is either
+// empty, or holds 7 bits of the hash of its element, so a lookup compares
+// 16 control bytes at once, with SSE2, and only compares the keys whose
+// bits match. The control bytes are followed by a copy of the first 15,
+// so a group which starts near the end wraps around. An element is always
+// before the first empty slot after the slot of its hash, so erasing
+// shifts the following elements back into the hole, instead of leaving
+// tombstones, and lookups never slow down after many erases. The table
+// grows to twice its capacity when it is 7/8 full. Element is the key in
+// Hash_Set, and a Hash_Entry with the key and the value in Hash_Map.
+// Floating point keys are compared with ==, so 0.0 and -0.0 are the same
+// key, and NaN is not accepted as a key
+template <typename Key, typename Element>
+class Hash_Table {
+   private:
+    static_assert(std::is_arithmetic<Key>::value && (sizeof(Key) <= sizeof(uint64_t)), "The keys of Hash_Table must be integers or floating point numbers of up to 64 bits");
+    static_assert(alignof(Element) <= alignof(std::max_align_t), "Hash_Table allocates with malloc, which does not support over-aligned types");
+
+    Element *values;
+    uint8_t *control;  // After the elements, in the same allocation
+    size_t _capacity;
+    size_t len;
+
+    size_t mask(void) const { return _capacity - 1; }
+    static uint8_t hash_tag(const uint64_t hash) { return static_cast<uint8_t>(hash >> 57); }
+    static size_t maximum_length(const size_t capacity) { return capacity - capacity / 8; }
+    static const Key &key_of(const Element &element) { return hash_element_key(element); }
+    static void check_key(const Key &key);
+    void allocate(const size_t capacity);
+    void set_control(const size_t index, const uint8_t tag);
+    size_t find_index(const Key &key) const;
+    size_t find_empty(const uint64_t hash) const;
+    void rehash(const size_t capacity);
+    void destroy_all(void);
+
+   public:
+    Hash_Table(void) : values(nullptr), control(nullptr), _capacity(0), len(0) {}
+    Hash_Table(const Hash_Table &to_copy);
+    Hash_Table(Hash_Table &&to_move);
+    ~Hash_Table(void);
+    Hash_Table &operator=(const Hash_Table &to_copy);
+    Hash_Table &operator=(Hash_Table &&to_move);
+    std::string to_string(void) const;
+    size_t length(void) const { return len; }
+    size_t capacity(void) const { return _capacity; }
+    void reserve(const size_t length);
+    void clear(void);
+    template <typename... Arguments>
+    bool insert(const Key &key, Arguments &&...arguments);
+    bool contains(const Key &key) const;
+    bool erase(const Key &key);
+    template <typename Entry = Element>
+    typename Entry::Value_Type value_at(const Key &key) const;
+    template <typename Entry = Element>
+    typename Entry::Value_Type &operator[](const Key &key);
+
+    // Iterators
+    template <bool Const>
+    class Hash_Iterator;
+    Hash_Iterator<false> begin(void) { return Hash_Iterator<false>(this, 0); }
+    Hash_Iterator<false> end(void) { return Hash_Iterator<false>(this, _capacity); }
+    Hash_Iterator<true> begin(void) const { return Hash_Iterator<true>(this, 0); }
+    Hash_Iterator<true> end(void) const { return Hash_Iterator<true>(this, _capacity); }
+};
+
+template <typename Key>
+using Hash_Set = Hash_Table<Key, Key>;
+
+template <typename Key, typename Value>
+using Hash_Map = Hash_Table<Key, Hash_Entry<Key, Value>>;
+
+// Visits the occupied slots in order. Elements of a Hash_Set are constant,
+// as changing them would change their hash
+template <typename Key, typename Element>
+template <bool Const>
+class Hash_Table<Key, Element>::Hash_Iterator {
+   private:
+    typedef typename std::conditional<Const, const Hash_Table, Hash_Table>::type Table;
+    typedef typename std::conditional<Const || std::is_same<Key, Element>::value, const Element, Element>::type Visited;
+
+    Table *table;
+    size_t index;
+
+    void skip_empty(void) {
+        while ((index < table->_capacity) && (table->control[index] == hash_empty)) {
+            index++;
+        }
+    }
+
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Element value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Visited *pointer;
+    typedef Visited &reference;
+
+    Hash_Iterator(Table *table, const size_t index) : table(table), index(index) { skip_empty(); }
+    Visited &operator*(void) const { return table->values[index]; }
+    Visited *operator->(void) const { return &**this; }
+    Hash_Iterator &operator++(void) {
+        index++;
+        skip_empty();
+        return *this;
+    }
+    Hash_Iterator operator++(int) {
+        Hash_Iterator previous = *this;
+        ++*this;
+        return previous;
+    }
+    bool operator!=(const Hash_Iterator &it) const { return (index != it.index); }
+    bool operator==(const Hash_Iterator &it) const { return (index == it.index); }
+};
+
+// Same capacity and layout, so the elements are copied without rehashing
+template <typename Key, typename Element>
+Hash_Table<Key, Element>::Hash_Table(const Hash_Table<Key, Element> &to_copy) : Hash_Table() {
+    if (to_copy.len == 0) {
+        return;
+    }
+    allocate(to_copy._capacity);
+    for (size_t i = 0; i < _capacity; i++) {
+        if (to_copy.control[i] != hash_empty) {
+            new (values + i) Element(to_copy.values[i]);
+            set_control(i, to_copy.control[i]);
+            len++;
+        }
+    }
+}
+
+template <typename Key, typename Element>
+Hash_Table<Key, Element>::Hash_Table(Hash_Table<Key, Element> &&to_move) : values(to_move.values), control(to_move.control), _capacity(to_move._capacity), len(to_move.len) {
+    to_move.values = nullptr;
+    to_move.control = nullptr;
+    to_move._capacity = 0;
+    to_move.len = 0;
+}
+
+template <typename Key, typename Element>
+Hash_Table<Key, Element>::~Hash_Table(void) {
+    destroy_all();
+    std::free(values);
+}
+
+template <typename Key, typename Element>
+Hash_Table<Key, Element> &Hash_Table<Key, Element>::operator=(const Hash_Table<Key, Element> &to_copy) {
+    if (this != &to_copy) {
+        *this = Hash_Table<Key, Element>(to_copy);
+    }
+    return *this;
+}
+
+template <typename Key, typename Element>
+Hash_Table<Key, Element> &Hash_Table<Key, Element>::operator=(Hash_Table<Key, Element> &&to_move) {
+    if (this != &to_move) {
+        destroy_all();
+        std::free(values);
+        values = to_move.values;
+        control = to_move.control;
+        _capacity = to_move._capacity;
+        len = to_move.len;
+        to_move.values = nullptr;
+        to_move.control = nullptr;
+        to_move._capacity = 0;
+        to_move.len = 0;
+    }
+    return *this;
+}
+
+template <typename Key, typename Element>
+std::ostream &operator<<(std::ostream &os, const Hash_Table<Key, Element> &table) {
+    return os << table.to_string();
+}
+
+template <typename Key, typename Element>
+std::string Hash_Table<Key, Element>::to_string(void) const {
+    std::ostringstream strs;
+    strs << "Hash table length: " << len << ", capacity: " << _capacity << std::endl;
+    for (size_t i = 0; i < _capacity; i++) {
+        if (control[i] != hash_empty) {
+            strs << "[" << std::setw(3) << i << "]: " << values[i] << std::endl;
+        }
+    }
+    return strs.str();
+}
+
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::check_key(const Key &key) {
+    // NaN is not equal to itself, so it could never be found
+    if (std::isnan(key)) {
+        throw std::runtime_error("Trying to use NaN as a key of a hash table!");
+    }
+}
+
+// Empty table with room for capacity elements, which is a power of two
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::allocate(const size_t capacity) {
+    const size_t control_bytes = capacity + hash_group_width - 1;
+    void *memory = std::malloc(capacity * sizeof(Element) + control_bytes);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    values = static_cast<Element *>(memory);
+    control = reinterpret_cast<uint8_t *>(values + capacity);
+    std::memset(control, hash_empty, control_bytes);
+    _capacity = capacity;
+    len = 0;
+}
+
+// Also writes the copy of the first control bytes, after the last one
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::set_control(const size_t index, const uint8_t tag) {
+    control[index] = tag;
+    if (index < hash_group_width - 1) {
+        control[_capacity + index] = tag;
+    }
+}
+
+// Index of the key, or the capacity if it is not in the table. Only the
+// slots before the first empty one can hold the key
+template <typename Key, typename Element>
+size_t Hash_Table<Key, Element>::find_index(const Key &key) const {
+    if (len == 0) {
+        return _capacity;
+    }
+    const uint64_t hash = hash_key(key);
+    const uint8_t tag = hash_tag(hash);
+    for (size_t position = static_cast<size_t>(hash) & mask();; position = (position + hash_group_width) & mask()) {
+        const uint8_t *group = control + position;
+        const uint32_t empties = hash_group_empties(group);
+        uint32_t candidates = hash_group_matches(group, tag) & ((empties - 1) & ~empties);
+        while (candidates != 0) {
+            const size_t index = (position + static_cast<size_t>(__builtin_ctz(candidates))) & mask();
+            if (key_of(values[index]) == key) {
+                return index;
+            }
+            candidates &= candidates - 1;
+        }
+        if (empties != 0) {
+            return _capacity;
+        }
+    }
+}
+
+// First empty slot at or after the slot of the hash
+template <typename Key, typename Element>
+size_t Hash_Table<Key, Element>::find_empty(const uint64_t hash) const {
+    for (size_t position = static_cast<size_t>(hash) & mask();; position = (position + hash_group_width) & mask()) {
+        const uint32_t empties = hash_group_empties(control + position);
+        if (empties != 0) {
+            return (position + static_cast<size_t>(__builtin_ctz(empties))) & mask();
+        }
+    }
+}
+
+// Moves the elements to a table of the given capacity
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::rehash(const size_t capacity) {
+    Element *old_values = values;
+    uint8_t *old_control = control;
+    const size_t old_capacity = _capacity;
+    const size_t old_length = len;
+    allocate(capacity);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_control[i] != hash_empty) {
+            const size_t index = find_empty(hash_key(key_of(old_values[i])));
+            new (values + index) Element(std::move(old_values[i]));
+            old_values[i].~Element();
+            set_control(index, old_control[i]);
+        }
+    }
+    len = old_length;
+    std::free(old_values);
+}
+
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::destroy_all(void) {
+    for (size_t i = 0; i < _capacity; i++) {
+        if (control[i] != hash_empty) {
+            values[i].~Element();
+            set_control(i, hash_empty);
+        }
+    }
+    len = 0;
+}
+
+// Grows the table, if needed, so that it holds length elements without
+// growing again
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::reserve(const size_t length) {
+    size_t capacity = (_capacity == 0) ? initial_hash_capacity : _capacity;
+    while (maximum_length(capacity) < length) {
+        capacity *= 2;
+    }
+    if (capacity != _capacity) {
+        rehash(capacity);
+    }
+}
+
+// Removes the elements, keeping the capacity
+template <typename Key, typename Element>
+void Hash_Table<Key, Element>::clear(void) {
+    destroy_all();
+}
+
+// Builds the element from the key and the arguments, if the key is not in
+// the table yet, and returns whether it was inserted. When the table must
+// grow, the element is built before, since the key and the arguments may
+// refer to elements of the table itself
+template <typename Key, typename Element>
+template <typename... Arguments>
+bool Hash_Table<Key, Element>::insert(const Key &key, Arguments &&...arguments) {
+    check_key(key);
+    if (find_index(key) != _capacity) {
+        return false;
+    }
+    const uint64_t hash = hash_key(key);
+    if (maximum_length(_capacity) < len + 1) {
+        Element element(key, std::forward<Arguments>(arguments)...);
+        reserve(len + 1);
+        const size_t index = find_empty(hash);
+        new (values + index) Element(std::move(element));
+        set_control(index, hash_tag(hash));
+    } else {
+        const size_t index = find_empty(hash);
+        new (values + index) Element(key, std::forward<Arguments>(arguments)...);
+        set_control(index, hash_tag(hash));
+    }
+    len++;
+    return true;
+}
+
+template <typename Key, typename Element>
+bool Hash_Table<Key, Element>::contains(const Key &key) const {
+    return find_index(key) != _capacity;
+}
+
+// The following elements which may be stored in the hole, because it is
+// between their slot and the slot of their hash, are shifted back
+template <typename Key, typename Element>
+bool Hash_Table<Key, Element>::erase(const Key &key) {
+    size_t hole = find_index(key);
+    if (hole == _capacity) {
+        return false;
+    }
+    values[hole].~Element();
+    for (size_t next = (hole + 1) & mask(); control[next] != hash_empty; next = (next + 1) & mask()) {
+        const size_t home = static_cast<size_t>(hash_key(key_of(values[next]))) & mask();
+        if (((next - home) & mask()) >= ((next - hole) & mask())) {
+            new (values + hole) Element(std::move(values[next]));
+            values[next].~Element();
+            set_control(hole, control[next]);
+            hole = next;
+        }
+    }
+    set_control(hole, hash_empty);
+    len--;
+    return true;
+}
+
+template <typename Key, typename Element>
+template <typename Entry>
+typename Entry::Value_Type Hash_Table<Key, Element>::value_at(const Key &key) const {
+    const size_t index = find_index(key);
+    if (index == _capacity) {
+        throw std::runtime_error("Didn't found the requested key in the hash table!");
+    }
+    return values[index].value;
+}
+
+// Inserts a value initialized element if the key is not in the table
+template <typename Key, typename Element>
+template <typename Entry>
+typename Entry::Value_Type &Hash_Table<Key, Element>::operator[](const Key &key) {
+    size_t index = find_index(key);
+    if (index == _capacity) {
+        insert(key);
+        index = find_index(key);
+    }
+    return values[index].value;
+}
+
+#endif  // __HASH_TABLE_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
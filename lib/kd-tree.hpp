@@ -0,0 +1,303 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __KD_TREE_CPP
+#define __KD_TREE_CPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+#include "scalar.hpp"
+#include "vector.hpp"
+
+// Number of queries answered by each task of the batched searches
+constexpr size_t kd_tree_query_chunk = 64;
+
+// k-d tree over points of any dimension. The node of a range [low, high)
+// of points is its middle element, the median along the dimension of
+// widest spread, and its children are the ranges at each side. So the
+// tree needs no pointers: the coordinates are stored in a single flat
+// array, in tree order
+template <typename Floating>
+class KD_Tree {
+   private:
+    size_t dim;
+    size_t count;
+    std::unique_ptr<Floating[]> coords;  // count * dim values, in tree order
+    std::unique_ptr<size_t[]> original;  // Index of each node in the input
+    std::unique_ptr<uint8_t[]> axis;     // Split dimension of each node
+
+    struct Range {
+        size_t low;
+        size_t high;
+    };
+    typedef std::pair<Floating, size_t> Neighbor;  // Squared distance and node
+
+    const Floating *point(const size_t node) const { return &coords[node * dim]; }
+    Floating squared_distance(const Floating *a, const Floating *b) const;
+    void split(size_t *order, const Floating *input, const Range range);
+    void build_subtree(size_t *order, const Floating *input, Range range);
+    void nearest(const Floating *query, const Range range, const size_t k, std::vector<Neighbor> &heap) const;
+    void radius(const Floating *query, const Range range, const Floating squared_radius, std::vector<size_t> &result) const;
+    void check_dimension(const Vector<Floating> &query) const;
+
+   public:
+    explicit KD_Tree(const std::vector<Vector<Floating>> &points);
+    size_t size(void) const { return count; }
+    size_t dimension(void) const { return dim; }
+    std::vector<size_t> nearest(const Vector<Floating> &query, const size_t k) const;
+    std::vector<size_t> radius(const Vector<Floating> &query, const Floating distance) const;
+    std::vector<std::vector<size_t>> nearest(const std::vector<Vector<Floating>> &queries, const size_t k) const;
+    std::vector<std::vector<size_t>> radius(const std::vector<Vector<Floating>> &queries, const Floating distance) const;
+};
+
+// The tree is built level by level, with one task per range, so the
+// first split is serial and the level k uses at most 2^k threads. When
+// there are enough ranges to keep the threads busy, each task builds a
+// whole subtree
+template <typename Floating>
+KD_Tree<Floating>::KD_Tree(const std::vector<Vector<Floating>> &points)
+    : dim(points.empty() ? 0 : points[0].length()), count(points.size()), coords(new Floating[points.size() * dim]), original(new size_t[points.size()]), axis(new uint8_t[points.size()]) {
+    if ((count != 0) && ((dim == 0) || (dim > UINT8_MAX))) {
+        throw std::runtime_error("Trying to build a k-d tree with an invalid dimension!");
+    }
+    for (const auto &p : points) {
+        if (p.length() != dim) {
+            throw std::runtime_error("Trying to build a k-d tree from points of different dimensions!");
+        }
+    }
+    std::unique_ptr<Floating[]> input(new Floating[count * dim]);
+    parallel_for(count, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            std::copy(points[i].begin(), points[i].end(), &input[i * dim]);
+            original[i] = i;
+        }
+    });
+    Thread_Pool &pool = parallel_pool();
+    std::vector<Range> level;
+    if (count != 0) {
+        level.push_back(Range{0, count});
+    }
+    while (!level.empty() && (level.size() < 4 * pool.threads())) {
+        pool.run(level.size(), [&](const size_t r) { split(original.get(), input.get(), level[r]); });
+        std::vector<Range> next;
+        for (const auto &range : level) {
+            const size_t middle = range.low + (range.high - range.low) / 2;
+            if (range.low < middle) {
+                next.push_back(Range{range.low, middle});
+            }
+            if (middle + 1 < range.high) {
+                next.push_back(Range{middle + 1, range.high});
+            }
+        }
+        level.swap(next);
+    }
+    pool.run(level.size(), [&](const size_t r) { build_subtree(original.get(), input.get(), level[r]); });
+    parallel_for(count, [&](const size_t begin, const size_t end) {
+        for (size_t node = begin; node < end; node++) {
+            std::copy(&input[original[node] * dim], &input[(original[node] + 1) * dim], &coords[node * dim]);
+        }
+    });
+}
+
+// Places the median of the range along the dimension of widest spread at
+// its middle, with the smaller points before it and the greater after it
+template <typename Floating>
+void KD_Tree<Floating>::split(size_t *order, const Floating *input, const Range range) {
+    uint8_t widest = 0;
+    Floating widest_spread = static_cast<Floating>(-1.0);
+    for (size_t d = 0; d < dim; d++) {
+        Floating low = static_cast<Floating>(INFINITY);
+        Floating high = static_cast<Floating>(-INFINITY);
+        for (size_t i = range.low; i < range.high; i++) {
+            low = minimum(low, input[order[i] * dim + d]);
+            high = maximum(high, input[order[i] * dim + d]);
+        }
+        if (high - low > widest_spread) {
+            widest_spread = high - low;
+            widest = static_cast<uint8_t>(d);
+        }
+    }
+    const size_t middle = range.low + (range.high - range.low) / 2;
+    std::nth_element(order + range.low, order + middle, order + range.high, [&](const size_t a, const size_t b) {
+        return input[a * dim + widest] < input[b * dim + widest];
+    });
+    axis[middle] = widest;
+}
+
+template <typename Floating>
+void KD_Tree<Floating>::build_subtree(size_t *order, const Floating *input, Range range) {
+    while (range.low < range.high) {
+        split(order, input, range);
+        const size_t middle = range.low + (range.high - range.low) / 2;
+        build_subtree(order, input, Range{range.low, middle});
+        range.low = middle + 1;
+    }
+}
+
+template <typename Floating>
+Floating KD_Tree<Floating>::squared_distance(const Floating *a, const Floating *b) const {
+    Floating sum = static_cast<Floating>(0.0);
+    for (size_t d = 0; d < dim; d++) {
+        const Floating diff = a[d] - b[d];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// Keeps the k closest nodes found so far in a max-heap, and skips the far
+// side of a split when the splitting plane is further than the worst of them
+template <typename Floating>
+void KD_Tree<Floating>::nearest(const Floating *query, const Range range, const size_t k, std::vector<Neighbor> &heap) const {
+    if (range.low >= range.high) {
+        return;
+    }
+    const size_t middle = range.low + (range.high - range.low) / 2;
+    const Floating *node = point(middle);
+    const Floating distance = squared_distance(query, node);
+    if (heap.size() < k) {
+        heap.push_back(Neighbor(distance, middle));
+        std::push_heap(heap.begin(), heap.end());
+    } else if (distance < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = Neighbor(distance, middle);
+        std::push_heap(heap.begin(), heap.end());
+    }
+    const Floating diff = query[axis[middle]] - node[axis[middle]];
+    const Range lower = Range{range.low, middle};
+    const Range upper = Range{middle + 1, range.high};
+    nearest(query, (diff < static_cast<Floating>(0.0)) ? lower : upper, k, heap);
+    if ((heap.size() < k) || (diff * diff < heap.front().first)) {
+        nearest(query, (diff < static_cast<Floating>(0.0)) ? upper : lower, k, heap);
+    }
+}
+
+template <typename Floating>
+void KD_Tree<Floating>::radius(const Floating *query, const Range range, const Floating squared_radius, std::vector<size_t> &result) const {
+    if (range.low >= range.high) {
+        return;
+    }
+    const size_t middle = range.low + (range.high - range.low) / 2;
+    const Floating *node = point(middle);
+    if (squared_distance(query, node) <= squared_radius) {
+        result.push_back(original[middle]);
+    }
+    const Floating diff = query[axis[middle]] - node[axis[middle]];
+    if ((diff <= static_cast<Floating>(0.0)) || (diff * diff <= squared_radius)) {
+        radius(query, Range{range.low, middle}, squared_radius, result);
+    }
+    if ((diff >= static_cast<Floating>(0.0)) || (diff * diff <= squared_radius)) {
+        radius(query, Range{middle + 1, range.high}, squared_radius, result);
+    }
+}
+
+template <typename Floating>
+void KD_Tree<Floating>::check_dimension(const Vector<Floating> &query) const {
+    if ((count != 0) && (query.length() != dim)) {
+        throw std::runtime_error("Query point and k-d tree with incompatible dimensions!");
+    }
+}
+
+// Returns the indices of the k points closest to query, nearest first
+template <typename Floating>
+std::vector<size_t> KD_Tree<Floating>::nearest(const Vector<Floating> &query, const size_t k) const {
+    check_dimension(query);
+    std::vector<Neighbor> heap;
+    heap.reserve(minimum(k, count));
+    if (k != 0) {
+        nearest(query.begin(), Range{0, count}, k, heap);
+    }
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<size_t> result(heap.size());
+    for (size_t i = 0; i < heap.size(); i++) {
+        result[i] = original[heap[i].second];
+    }
+    return result;
+}
+
+// Returns the indices of all the points within the given distance of
+// query, in no particular order
+template <typename Floating>
+std::vector<size_t> KD_Tree<Floating>::radius(const Vector<Floating> &query, const Floating distance) const {
+    check_dimension(query);
+    std::vector<size_t> result;
+    radius(query.begin(), Range{0, count}, distance * distance, result);
+    return result;
+}
+
+template <typename Floating>
+std::vector<std::vector<size_t>> KD_Tree<Floating>::nearest(const std::vector<Vector<Floating>> &queries, const size_t k) const {
+    std::vector<std::vector<size_t>> result(queries.size());
+    const size_t tasks = (queries.size() + kd_tree_query_chunk - 1) / kd_tree_query_chunk;
+    parallel_pool().run(tasks, [&](const size_t task) {
+        const size_t end = minimum((task + 1) * kd_tree_query_chunk, queries.size());
+        for (size_t i = task * kd_tree_query_chunk; i < end; i++) {
+            result[i] = nearest(queries[i], k);
+        }
+    });
+    return result;
+}
+
+template <typename Floating>
+std::vector<std::vector<size_t>> KD_Tree<Floating>::radius(const std::vector<Vector<Floating>> &queries, const Floating distance) const {
+    std::vector<std::vector<size_t>> result(queries.size());
+    const size_t tasks = (queries.size() + kd_tree_query_chunk - 1) / kd_tree_query_chunk;
+    parallel_pool().run(tasks, [&](const size_t task) {
+        const size_t end = minimum((task + 1) * kd_tree_query_chunk, queries.size());
+        for (size_t i = task * kd_tree_query_chunk; i < end; i++) {
+            result[i] = radius(queries[i], distance);
+        }
+    });
+    return result;
+}
+
+#endif  // __KD_TREE_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,375 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MAPPED_ARRAY_CPP
+#define __MAPPED_ARRAY_CPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "scalar.hpp"
+
+// The file starts with this header, padded to mapped_array_data_offset
+// bytes, followed by the elements
+struct Mapped_Array_Header {
+    char magic[8];
+    uint64_t element_size;
+    uint64_t length;
+};
+
+constexpr char mapped_array_magic[8] = {'M', 'A', 'P', 'A', 'R', 'R', 'A', 'Y'};
+constexpr size_t mapped_array_data_offset = 64;
+constexpr size_t mapped_array_initial_capacity = 1 << 10;
+
+// Expected access pattern, passed to madvise
+enum class Mapped_Access {
+    normal,
+    sequential,
+    random,
+};
+
+// Array stored in a file, which is mapped in memory, so its elements are
+// read and written in place, and reopening the file gives back the array
+// without parsing anything, as the pages are only read when touched. The
+// header holds the length and the size of the elements, and the capacity
+// is given by the size of the file. Growing doubles the file with
+// ftruncate and extends the mapping with mremap, which does not copy the
+// pages. The data survives if the process dies, as the kernel writes the
+// pages back, and sync() waits until they are on disk, as a checkpoint.
+// Only trivially copyable types can be stored, and the file is only
+// portable between machines with the same layout of the elements
+template <typename Number>
+class Mapped_Array {
+   private:
+    static_assert(std::is_trivially_copyable<Number>::value, "Mapped_Array only stores trivially copyable types");
+    static_assert(alignof(Number) <= mapped_array_data_offset, "The elements of Mapped_Array must fit the alignment of the data offset");
+    static_assert(sizeof(Mapped_Array_Header) <= mapped_array_data_offset, "The header of Mapped_Array must fit before the data");
+
+    int file;
+    char *memory;
+    size_t mapped_bytes;
+
+    Mapped_Array_Header *header(void) const { return reinterpret_cast<Mapped_Array_Header *>(memory); }
+    Number *values(void) const { return reinterpret_cast<Number *>(memory + mapped_array_data_offset); }
+    static size_t bytes_for(const size_t capacity) { return mapped_array_data_offset + capacity * sizeof(Number); }
+    void resize_file(const size_t capacity);
+    void release(void);
+
+   public:
+    explicit Mapped_Array(const std::string &path);
+    Mapped_Array(const Mapped_Array &to_copy) = delete;
+    Mapped_Array(Mapped_Array &&to_move);
+    ~Mapped_Array(void);
+    Mapped_Array &operator=(const Mapped_Array &to_copy) = delete;
+    Mapped_Array &operator=(Mapped_Array &&to_move);
+    std::string to_string(void) const;
+    size_t length(void) const { return static_cast<size_t>(header()->length); }
+    size_t capacity(void) const { return (mapped_bytes - mapped_array_data_offset) / sizeof(Number); }
+    void reserve(const size_t capacity);
+    void push(const Number &value);
+    Number pop(void);
+    void clear(void);
+    Number value_at(const size_t index) const;
+    size_t find(const Number &value) const;
+    Number &operator[](const size_t index) const;
+    void sync(void) const;
+    void advise(const Mapped_Access access) const;
+
+    // Iterators
+    Number *begin(void) { return values(); }
+    const Number *begin(void) const { return values(); }
+    Number *end(void) { return values() + length(); }
+    const Number *end(void) const { return values() + length(); }
+};
+
+// Error message with the description of an errno value, which callers
+// read right after the failed call, before any cleanup can change it
+std::string system_error_message(const std::string &message, const int error) {
+    return message + " (" + std::strerror(error) + ")!";
+}
+
+// Opens the array stored in the file at path, which is created if it does
+// not exist
+template <typename Number>
+Mapped_Array<Number>::Mapped_Array(const std::string &path) : file(-1), memory(nullptr), mapped_bytes(0) {
+    file = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) {
+        const int error = errno;
+        throw std::runtime_error(system_error_message("Trying to open the file " + path + " of a mapped array", error));
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        const int error = errno;
+        const std::string message = system_error_message("Trying to read the size of the file " + path + " of a mapped array", error);
+        release();
+        throw std::runtime_error(message);
+    }
+    const bool created = (status.st_size == 0);
+    size_t bytes = static_cast<size_t>(status.st_size);
+    if (created) {
+        bytes = bytes_for(mapped_array_initial_capacity);
+        if (ftruncate(file, static_cast<off_t>(bytes)) != 0) {
+            const int error = errno;
+            const std::string message = system_error_message("Trying to create the file " + path + " of a mapped array", error);
+            release();
+            throw std::runtime_error(message);
+        }
+    } else if (bytes < mapped_array_data_offset) {
+        release();
+        throw std::runtime_error("Trying to open the file " + path + ", which is not a mapped array!");
+    }
+    void *mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (mapping == MAP_FAILED) {
+        const int error = errno;
+        const std::string message = system_error_message("Trying to map the file " + path + " of a mapped array", error);
+        release();
+        throw std::runtime_error(message);
+    }
+    memory = static_cast<char *>(mapping);
+    mapped_bytes = bytes;
+    if (created) {
+        std::memcpy(header()->magic, mapped_array_magic, sizeof(mapped_array_magic));
+        header()->element_size = sizeof(Number);
+        header()->length = 0;
+    } else if ((std::memcmp(header()->magic, mapped_array_magic, sizeof(mapped_array_magic)) != 0) || (header()->element_size != sizeof(Number)) ||
+               (header()->length > capacity())) {
+        release();
+        throw std::runtime_error("Trying to open the file " + path + ", which is not a mapped array of this type!");
+    }
+}
+
+template <typename Number>
+Mapped_Array<Number>::Mapped_Array(Mapped_Array<Number> &&to_move) : file(to_move.file), memory(to_move.memory), mapped_bytes(to_move.mapped_bytes) {
+    to_move.file = -1;
+    to_move.memory = nullptr;
+    to_move.mapped_bytes = 0;
+}
+
+// Unmapping keeps the data, which the kernel writes back to the file
+template <typename Number>
+Mapped_Array<Number>::~Mapped_Array(void) {
+    release();
+}
+
+template <typename Number>
+Mapped_Array<Number> &Mapped_Array<Number>::operator=(Mapped_Array<Number> &&to_move) {
+    if (this != &to_move) {
+        release();
+        file = to_move.file;
+        memory = to_move.memory;
+        mapped_bytes = to_move.mapped_bytes;
+        to_move.file = -1;
+        to_move.memory = nullptr;
+        to_move.mapped_bytes = 0;
+    }
+    return *this;
+}
+
+template <typename Number>
+void Mapped_Array<Number>::release(void) {
+    if (memory != nullptr) {
+        munmap(memory, mapped_bytes);
+        memory = nullptr;
+        mapped_bytes = 0;
+    }
+    if (file >= 0) {
+        close(file);
+        file = -1;
+    }
+}
+
+template <typename Number>
+std::ostream &operator<<(std::ostream &os, const Mapped_Array<Number> &array) {
+    return os << array.to_string();
+}
+
+template <typename Number>
+std::string Mapped_Array<Number>::to_string(void) const {
+    std::ostringstream strs;
+    strs << "Array length: " << length() << ", capacity: " << capacity() << std::endl;
+    for (size_t i = 0; i < length(); i++) {
+        strs << "[" << std::setw(3) << i << "]: " << values()[i] << std::endl;
+    }
+    return strs.str();
+}
+
+// Grows the file and the mapping to hold capacity elements. Elsewhere than
+// Linux, which has no mremap, the file is mapped again
+template <typename Number>
+void Mapped_Array<Number>::resize_file(const size_t capacity) {
+    const size_t bytes = bytes_for(capacity);
+    if (ftruncate(file, static_cast<off_t>(bytes)) != 0) {
+        const int error = errno;
+        throw std::runtime_error(system_error_message("Trying to grow the file of a mapped array", error));
+    }
+#if defined(__linux__)
+    void *mapping = mremap(memory, mapped_bytes, bytes, MREMAP_MAYMOVE);
+#else
+    // The old mapping is kept until the new one exists
+    void *mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (mapping != MAP_FAILED) {
+        munmap(memory, mapped_bytes);
+    }
+#endif
+    if (mapping == MAP_FAILED) {
+        const int error = errno;
+        throw std::runtime_error(system_error_message("Trying to map the grown file of a mapped array", error));
+    }
+    memory = static_cast<char *>(mapping);
+    mapped_bytes = bytes;
+}
+
+template <typename Number>
+void Mapped_Array<Number>::reserve(const size_t capacity) {
+    if (capacity > this->capacity()) {
+        resize_file(capacity);
+    }
+}
+
+// The element is written before the length, so a crash leaves either the
+// old or the new length, and never one which covers unwritten data
+template <typename Number>
+void Mapped_Array<Number>::push(const Number &value) {
+    const size_t index = length();
+    if (index == capacity()) {
+        // The value may be in the mapping, which can move
+        const Number copy = value;
+        resize_file(maximum(2 * capacity(), mapped_array_initial_capacity));
+        values()[index] = copy;
+    } else {
+        values()[index] = value;
+    }
+    header()->length = index + 1;
+}
+
+template <typename Number>
+Number Mapped_Array<Number>::pop(void) {
+    if (length() == 0) {
+        throw std::runtime_error("Trying to pop an empty array!");
+    }
+    header()->length--;
+    return values()[length()];
+}
+
+// Empties the array, keeping the size of the file
+template <typename Number>
+void Mapped_Array<Number>::clear(void) {
+    header()->length = 0;
+}
+
+template <typename Number>
+Number Mapped_Array<Number>::value_at(const size_t index) const {
+    if (index >= length()) {
+        throw std::runtime_error("Trying to access the array in invalid range!");
+    }
+    return values()[index];
+}
+
+template <typename Number>
+size_t Mapped_Array<Number>::find(const Number &value) const {
+    // Sequential search
+    for (size_t i = 0; i < length(); i++) {
+        if (values()[i] == value) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Didn't found the requested value in the array!");
+}
+
+template <typename Number>
+Number &Mapped_Array<Number>::operator[](const size_t index) const {
+    if (index >= length()) {
+        throw std::runtime_error("Trying to access mapped array in invalid range!");
+    }
+    return values()[index];
+}
+
+// Checkpoint: returns when the elements and the header are on disk
+template <typename Number>
+void Mapped_Array<Number>::sync(void) const {
+    if (msync(memory, mapped_bytes, MS_SYNC) != 0) {
+        const int error = errno;
+        throw std::runtime_error(system_error_message("Trying to write the mapped array to its file", error));
+    }
+}
+
+// Tells the kernel how the elements will be read, so it reads ahead
+// aggressively for sequential access, and not at all for random access
+template <typename Number>
+void Mapped_Array<Number>::advise(const Mapped_Access access) const {
+    int advice = MADV_NORMAL;
+    switch (access) {
+        case Mapped_Access::normal:
+            advice = MADV_NORMAL;
+            break;
+        case Mapped_Access::sequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case Mapped_Access::random:
+            advice = MADV_RANDOM;
+            break;
+    }
+    if (madvise(memory, mapped_bytes, advice) != 0) {
+        const int error = errno;
+        throw std::runtime_error(system_error_message("Trying to advise the kernel on the access to a mapped array", error));
+    }
+}
+
+#endif  // __MAPPED_ARRAY_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
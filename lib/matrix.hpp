@@ -28,11 +28,145 @@
 #include <iostream>
 #include <sstream>
 
+#include "parallel.hpp"
+#include "random.hpp"
 #include "scalar.hpp"
+#include "simd.hpp"
 #include "vector.hpp"
 
 constexpr uint64_t matrix_iterations = 10000;
 constexpr double matrix_precision = 1e-9;
+// Side of the square tiles of the blocked transpose. A tile of doubles and
+// its transpose take 16 KiB, so both stay in L1 while the tile is copied
+constexpr size_t matrix_transpose_tile = 32;
+
+// Blocking of the matrix product: panels of B with gemm_block_inner rows
+// and gemm_block_cols columns (256 KiB of doubles) stay in L2 while every
+// row of A goes through them. Tasks get gemm_block_rows rows of C each
+constexpr size_t gemm_block_inner = 128;
+constexpr size_t gemm_block_cols = 256;
+constexpr size_t gemm_block_rows = 64;
+
+// C[rows x cols] += A[rows x inner] * B[inner x cols], where lda, ldb and
+// ldc are the row lengths of each array. A tile of 4 rows and 2 registers
+// of C is kept in registers for the whole depth, so every element of B
+// loaded is used 4 times and every element of A broadcast is used
+// 2 * Simd<Floating>::width times. Edges are handled one element at a time
+template <typename Floating>
+void gemm_kernel(const Floating *a, const Floating *b, Floating *c, const size_t rows, const size_t inner, const size_t cols, const size_t lda, const size_t ldb, const size_t ldc) {
+    typedef Simd<Floating> Pack;
+    const size_t width = Pack::width;
+    size_t i = 0;
+    for (; i + 4 <= rows; i += 4) {
+        const Floating *a0 = a + i * lda;
+        const Floating *a1 = a0 + lda;
+        const Floating *a2 = a1 + lda;
+        const Floating *a3 = a2 + lda;
+        Floating *c0 = c + i * ldc;
+        Floating *c1 = c0 + ldc;
+        Floating *c2 = c1 + ldc;
+        Floating *c3 = c2 + ldc;
+        size_t j = 0;
+        for (; j + 2 * width <= cols; j += 2 * width) {
+            Pack c00 = Pack::load(c0 + j), c01 = Pack::load(c0 + j + width);
+            Pack c10 = Pack::load(c1 + j), c11 = Pack::load(c1 + j + width);
+            Pack c20 = Pack::load(c2 + j), c21 = Pack::load(c2 + j + width);
+            Pack c30 = Pack::load(c3 + j), c31 = Pack::load(c3 + j + width);
+            for (size_t k = 0; k < inner; k++) {
+                const Pack b0 = Pack::load(b + k * ldb + j);
+                const Pack b1 = Pack::load(b + k * ldb + j + width);
+                const Pack x0(a0[k]), x1(a1[k]), x2(a2[k]), x3(a3[k]);
+                c00 = multiply_add(x0, b0, c00);
+                c01 = multiply_add(x0, b1, c01);
+                c10 = multiply_add(x1, b0, c10);
+                c11 = multiply_add(x1, b1, c11);
+                c20 = multiply_add(x2, b0, c20);
+                c21 = multiply_add(x2, b1, c21);
+                c30 = multiply_add(x3, b0, c30);
+                c31 = multiply_add(x3, b1, c31);
+            }
+            c00.store(c0 + j);
+            c01.store(c0 + j + width);
+            c10.store(c1 + j);
+            c11.store(c1 + j + width);
+            c20.store(c2 + j);
+            c21.store(c2 + j + width);
+            c30.store(c3 + j);
+            c31.store(c3 + j + width);
+        }
+        for (; j < cols; j++) {
+            for (size_t k = 0; k < inner; k++) {
+                const Floating value = b[k * ldb + j];
+                c0[j] += a0[k] * value;
+                c1[j] += a1[k] * value;
+                c2[j] += a2[k] * value;
+                c3[j] += a3[k] * value;
+            }
+        }
+    }
+    for (; i < rows; i++) {
+        for (size_t k = 0; k < inner; k++) {
+            const Floating scale = a[i * lda + k];
+            for (size_t j = 0; j < cols; j++) {
+                c[i * ldc + j] += scale * b[k * ldb + j];
+            }
+        }
+    }
+}
+
+// C[rows x cols] += A[rows x inner] * B[inner x cols], all contiguous and
+// row-major. Bands of rows are distributed over parallel_pool() when the
+// product is large enough
+template <typename Floating>
+void gemm(const Floating *a, const Floating *b, Floating *c, const size_t rows, const size_t inner, const size_t cols) {
+    const size_t bands = (rows + gemm_block_rows - 1) / gemm_block_rows;
+    const auto band_task = [&](const size_t band) {
+        const size_t first = band * gemm_block_rows;
+        const size_t count = minimum(gemm_block_rows, rows - first);
+        for (size_t k = 0; k < inner; k += gemm_block_inner) {
+            const size_t depth = minimum(gemm_block_inner, inner - k);
+            for (size_t j = 0; j < cols; j += gemm_block_cols) {
+                const size_t width = minimum(gemm_block_cols, cols - j);
+                gemm_kernel(a + first * inner + k, b + k * cols + j, c + first * cols + j, count, depth, width, inner, cols, cols);
+            }
+        }
+    };
+    if ((rows * inner * cols) < parallel_policy().threshold * 64) {
+        for (size_t band = 0; band < bands; band++) {
+            band_task(band);
+        }
+    } else {
+        parallel_pool().run(bands, band_task);
+    }
+}
+
+// Transposes the rows [band * tile, (band + 1) * tile) of the rows x cols
+// row-major array input into output. A naive transpose reads or writes
+// with a stride of a whole row, touching a new cache line on every
+// element; going through square tiles uses each line loaded several times
+// before it is evicted
+template <typename Element>
+void transpose_band(const Element *input, const size_t rows, const size_t cols, Element *output, const size_t band) {
+    const size_t tile = matrix_transpose_tile;
+    const size_t row_end = minimum(rows, (band + 1) * tile);
+    for (size_t col = 0; col < cols; col += tile) {
+        const size_t col_end = minimum(cols, col + tile);
+        for (size_t i = band * tile; i < row_end; i++) {
+            for (size_t j = col; j < col_end; j++) {
+                output[j * rows + i] = input[i * cols + j];
+            }
+        }
+    }
+}
+
+// Blocked transpose with the bands of tiles distributed over pool
+template <typename Element>
+void transpose_blocked(const Element *input, const size_t rows, const size_t cols, Element *output, Thread_Pool &pool) {
+    const size_t bands = (rows + matrix_transpose_tile - 1) / matrix_transpose_tile;
+    pool.run(bands, [&](const size_t band) {
+        transpose_band(input, rows, cols, output, band);
+    });
+}
 
 template <typename Floating>
 class Matrix {
@@ -60,7 +194,8 @@ class Matrix {
     bool operator==(const Matrix &matrix) const;
     bool operator!=(const Matrix &matrix) const;
     void resize(const size_t rows, const size_t cols);
-    Matrix &random(const Floating min, const Floating max);
+    Matrix &random(const Floating min, const Floating max, const uint64_t seed = random_seed());
+    Matrix &random_normal(const Floating mean, const Floating deviation, const uint64_t seed = random_seed());
     std::string to_string(void) const;
     bool is_squared(void) const;
     bool is_symmetric(void) const;
@@ -72,6 +207,12 @@ class Matrix {
     Matrix skew_symmetric(void) const;
     Matrix inverse(void) const;
     static Matrix identity(const size_t rows);
+
+    // Iterators, over the elements in row-major order
+    Floating *begin(void) { return data; }
+    const Floating *begin(void) const { return data; }
+    Floating *end(void) { return data + _rows * _cols; }
+    const Floating *end(void) const { return data + _rows * _cols; }
 };
 
 template <typename Floating>
@@ -172,13 +313,7 @@ Matrix<Floating> Matrix<Floating>::operator*(const Matrix &matrix) const {
     }
     Matrix<Floating> result(_rows, matrix._cols);
     result = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < result._rows; i++) {
-        for (size_t j = 0; j < result._cols; j++) {
-            for (size_t k = 0; k < _cols; k++) {
-                result(i, j) += this->operator()(i, k) * matrix(k, j);
-            }
-        }
-    }
+    gemm(data, matrix.data, result.data, _rows, _cols, matrix._cols);
     return result;
 }
 
@@ -243,11 +378,14 @@ void Matrix<Floating>::resize(const size_t rows, const size_t cols) {
 }
 
 template <typename Floating>
-Matrix<Floating> &Matrix<Floating>::random(const Floating min, const Floating max) {
-    srand(static_cast<unsigned int>(time(NULL)));
-    for (size_t i = 0; i < (_rows * _cols); i++) {
-        data[i] = random_number<Floating>(min, max);
-    }
+Matrix<Floating> &Matrix<Floating>::random(const Floating min, const Floating max, const uint64_t seed) {
+    fill_uniform(data, (_rows * _cols), min, max, seed);
+    return *this;
+}
+
+template <typename Floating>
+Matrix<Floating> &Matrix<Floating>::random_normal(const Floating mean, const Floating deviation, const uint64_t seed) {
+    fill_normal(data, (_rows * _cols), mean, deviation, seed);
     return *this;
 }
 
@@ -330,7 +468,7 @@ Floating Matrix<Floating>::determinant(void) const {
     // Forward elimination (Gauss)
     for (size_t k = 0; (k + 1) < matrix._rows; k++) {
         for (size_t i = (k + 1); i < matrix._rows; i++) {
-            const double m = matrix(i, k) / matrix(k, k);
+            const Floating m = matrix(i, k) / matrix(k, k);
             for (size_t j = (k + 1); j < matrix._rows; j++) {
                 matrix(i, j) -= m * matrix(k, j);
             }
@@ -346,10 +484,12 @@ Floating Matrix<Floating>::determinant(void) const {
 template <typename Floating>
 Matrix<Floating> Matrix<Floating>::transpose(void) const {
     Matrix<Floating> transpose(_cols, _rows);
-    for (size_t i = 0; i < _rows; i++) {
-        for (size_t j = 0; j < _cols; j++) {
-            transpose(j, i) = this->operator()(i, j);
+    if ((_rows * _cols) < parallel_policy().threshold) {
+        for (size_t band = 0; band * matrix_transpose_tile < _rows; band++) {
+            transpose_band(data, _rows, _cols, transpose.data, band);
         }
+    } else {
+        transpose_blocked(data, _rows, _cols, transpose.data, parallel_pool());
     }
     return transpose;
 }
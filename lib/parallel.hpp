@@ -0,0 +1,259 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __PARALLEL_CPP
+#define __PARALLEL_CPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "scalar.hpp"
+
+// Ranges shorter than this are processed serially, since waking the
+// workers costs more than what the extra memory bandwidth gives back
+constexpr size_t parallel_threshold = 1 << 17;
+// Number of elements processed by each task. It does not depend on the
+// number of threads, so parallel reductions always combine the same
+// partial results in the same order
+constexpr size_t parallel_chunk_length = 1 << 14;
+
+// Set while the current thread is executing a task, so nested parallel
+// calls run serially instead of waiting for a busy pool
+thread_local bool inside_parallel_task = false;
+
+class Thread_Pool {
+   private:
+    std::vector<std::thread> workers;
+    std::mutex run_mutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)> *job;
+    size_t job_tasks;
+    std::atomic<size_t> next_task;
+    size_t pending_workers;
+    uint64_t generation;
+    bool stopping;
+    std::exception_ptr error;
+
+    void work(void);
+    void execute(void);
+
+   public:
+    explicit Thread_Pool(const size_t threads);
+    ~Thread_Pool(void);
+    Thread_Pool(const Thread_Pool &) = delete;
+    Thread_Pool &operator=(const Thread_Pool &) = delete;
+    size_t threads(void) const { return workers.size() + 1; }
+    void run(const size_t tasks, const std::function<void(size_t)> &task);
+    static Thread_Pool &shared(void);
+};
+
+// The calling thread also executes tasks, so a pool of n threads
+// creates only (n - 1) workers
+Thread_Pool::Thread_Pool(const size_t threads) : job(nullptr), job_tasks(0), next_task(0), pending_workers(0), generation(0), stopping(false) {
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back(&Thread_Pool::work, this);
+    }
+}
+
+Thread_Pool::~Thread_Pool(void) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void Thread_Pool::execute(void) {
+    inside_parallel_task = true;
+    for (size_t task = next_task++; task < job_tasks; task = next_task++) {
+        try {
+            (*job)(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    inside_parallel_task = false;
+}
+
+void Thread_Pool::work(void) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || (generation != seen); });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        execute();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending_workers--;
+            if (pending_workers == 0) {
+                done.notify_one();
+            }
+        }
+    }
+}
+
+// Calls task(0) ... task(tasks - 1) across the pool and waits for all of
+// them. Exceptions thrown by the tasks are rethrown in the calling thread
+void Thread_Pool::run(const size_t tasks, const std::function<void(size_t)> &task) {
+    if (workers.empty() || (tasks <= 1) || inside_parallel_task) {
+        for (size_t i = 0; i < tasks; i++) {
+            task(i);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> serialize(run_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        job_tasks = tasks;
+        next_task = 0;
+        pending_workers = workers.size();
+        error = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+    execute();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return pending_workers == 0; });
+    job = nullptr;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+Thread_Pool &Thread_Pool::shared(void) {
+    static Thread_Pool pool(maximum<size_t>(std::thread::hardware_concurrency(), 1));
+    return pool;
+}
+
+// Process-wide execution policy of the Vector operations
+struct Parallel_Policy {
+    Thread_Pool *pool;  // nullptr selects the shared pool
+    size_t threshold;   // shorter ranges run serially
+};
+
+Parallel_Policy &parallel_policy(void) {
+    static Parallel_Policy policy = {nullptr, parallel_threshold};
+    return policy;
+}
+
+Thread_Pool &parallel_pool(void) {
+    const Parallel_Policy &policy = parallel_policy();
+    return (policy.pool != nullptr) ? *policy.pool : Thread_Pool::shared();
+}
+
+size_t parallel_chunks(const size_t length) {
+    return (length + parallel_chunk_length - 1) / parallel_chunk_length;
+}
+
+// Calls body(begin, end) for consecutive chunks covering [0, length)
+template <typename Body>
+void parallel_for(const size_t length, const Body &body) {
+    const size_t chunks = parallel_chunks(length);
+    const auto task = [&](const size_t chunk) {
+        const size_t begin = chunk * parallel_chunk_length;
+        body(begin, minimum(begin + parallel_chunk_length, length));
+    };
+    if (length < parallel_policy().threshold) {
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            task(chunk);
+        }
+        return;
+    }
+    parallel_pool().run(chunks, task);
+}
+
+// Reduces [0, length) with map(begin, end) on each chunk and folds the
+// partial results with combine, always in chunk order. The serial path
+// uses the same chunks, so the result doesn't depend on the threshold or
+// on the number of threads
+template <typename Result, typename Map, typename Combine>
+Result parallel_reduce(const size_t length, const Result identity, const Map &map, const Combine &combine) {
+    const size_t chunks = parallel_chunks(length);
+    Result result = identity;
+    if (length < parallel_policy().threshold) {
+        // Short ranges, such as small vectors, allocate nothing
+        for (size_t begin = 0; begin < length; begin += parallel_chunk_length) {
+            result = combine(result, map(begin, minimum(begin + parallel_chunk_length, length)));
+        }
+        return result;
+    }
+    // Not a std::vector, since std::vector<bool> packs its elements in
+    // shared words and the tasks write their partial results concurrently
+    std::unique_ptr<Result[]> partial(new Result[chunks]);
+    parallel_pool().run(chunks, [&](const size_t chunk) {
+        const size_t begin = chunk * parallel_chunk_length;
+        partial[chunk] = map(begin, minimum(begin + parallel_chunk_length, length));
+    });
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        result = combine(result, partial[chunk]);
+    }
+    return result;
+}
+
+#endif  // __PARALLEL_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
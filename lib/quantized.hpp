@@ -0,0 +1,262 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __QUANTIZED_CPP
+#define __QUANTIZED_CPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "matrix.hpp"
+#include "scalar.hpp"
+#include "vector.hpp"
+
+// Longest block whose dot product fits 32 bits: 2^16 * 255 * 127 < 2^31
+constexpr size_t quantized_block_length = 1 << 16;
+
+// Dot product of unsigned and signed 8-bit integers, accumulated in 32
+// bits, for at most quantized_block_length elements. With VNNI, vpdpbusd
+// multiplies and accumulates 32 pairs per instruction. AVX2 widens to 16
+// bits and uses vpmaddwd instead of vpmaddubsw, since the latter
+// saturates when two products of 255 * 127 are added. Plain x86-64 still
+// has SSE2, which widens by unpacking
+int32_t dot_product_block(const uint8_t *a, const int8_t *b, const size_t length) {
+    size_t i = 0;
+    int32_t sum = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+#if (defined(__AVX512VNNI__) && defined(__AVX512VL__)) || defined(__AVXVNNI__)
+    for (; i + 32 <= length; i += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        acc = _mm256_dpbusd_epi32(acc, va, vb);
+#else
+        acc = _mm256_dpbusd_avx_epi32(acc, va, vb);
+#endif
+    }
+#endif
+    for (; i + 16 <= length; i += 16) {
+        const __m256i va = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)));
+        const __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+    const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    const __m128i quarter = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4e));
+    sum = _mm_cvtsi128_si32(_mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0xb1)));
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        // Each signed byte is duplicated in a 16-bit lane and shifted back
+        // down with sign extension
+        const __m128i b_low = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+        const __m128i b_high = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(va, zero), b_low));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(va, zero), b_high));
+    }
+    const __m128i half = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+    sum = _mm_cvtsi128_si32(_mm_add_epi32(half, _mm_shuffle_epi32(half, 0xb1)));
+#else
+    int32_t partial[4] = {0, 0, 0, 0};
+    for (; i + 4 <= length; i += 4) {
+        for (size_t j = 0; j < 4; j++) {
+            partial[j] += static_cast<int32_t>(a[i + j]) * static_cast<int32_t>(b[i + j]);
+        }
+    }
+    sum = partial[0] + partial[1] + partial[2] + partial[3];
+#endif
+    for (; i < length; i++) {
+        sum += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return sum;
+}
+
+// The blocks are accumulated in 64 bits, so rows of any length are exact
+int64_t dot_product(const uint8_t *a, const int8_t *b, const size_t length) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < length; i += quantized_block_length) {
+        sum += dot_product_block(a + i, b + i, minimum(length - i, quantized_block_length));
+    }
+    return sum;
+}
+
+// Vector quantized to signed 8-bit integers in [-127, 127] with a single
+// scale, so value[i] ~ scale * data[i]. Zero is always exact
+class Quantized_Vector {
+   private:
+    size_t len;
+    std::unique_ptr<int8_t[]> data;
+    float _scale;
+    int64_t _sum;  // Sum of the quantized values
+
+   public:
+    explicit Quantized_Vector(const float *values, const size_t length);
+    explicit Quantized_Vector(const Vector<float> &vector) : Quantized_Vector(vector.begin(), vector.length()) {}
+    size_t length(void) const { return len; }
+    float scale(void) const { return _scale; }
+    int64_t sum(void) const { return _sum; }
+    const int8_t *begin(void) const { return data.get(); }
+    const int8_t *end(void) const { return data.get() + len; }
+};
+
+Quantized_Vector::Quantized_Vector(const float *values, const size_t length) : len(length), data(new int8_t[length]), _scale(1.0f), _sum(0) {
+    float largest = 0.0f;
+    for (size_t i = 0; i < len; i++) {
+        largest = maximum(largest, std::fabs(values[i]));
+    }
+    if (largest > 0.0f) {
+        _scale = largest / 127.0f;
+    }
+    for (size_t i = 0; i < len; i++) {
+        const float q = minimum(maximum(round<float>(values[i] / _scale), -127.0f), 127.0f);
+        data[i] = static_cast<int8_t>(q);
+        _sum += data[i];
+    }
+}
+
+// Matrix quantized row by row to unsigned 8-bit integers, with a scale and
+// a zero point per row: value(i, j) ~ scale(i) * (data(i, j) - zero_point(i)).
+// The range of each row is widened to include zero, so zero is exact
+class Quantized_Matrix {
+   private:
+    size_t _rows;
+    size_t _cols;
+    std::unique_ptr<uint8_t[]> data;
+    std::unique_ptr<float[]> scales;
+    std::unique_ptr<int32_t[]> zero_points;
+
+   public:
+    explicit Quantized_Matrix(const Matrix<float> &matrix);
+    size_t rows(void) const { return _rows; }
+    size_t cols(void) const { return _cols; }
+    float scale(const size_t row) const { return scales[row]; }
+    int32_t zero_point(const size_t row) const { return zero_points[row]; }
+    const uint8_t *row(const size_t row) const { return &data[row * _cols]; }
+    Matrix<float> dequantize(void) const;
+};
+
+Quantized_Matrix::Quantized_Matrix(const Matrix<float> &matrix)
+    : _rows(matrix.rows()), _cols(matrix.cols()), data(new uint8_t[matrix.rows() * matrix.cols()]), scales(new float[matrix.rows()]), zero_points(new int32_t[matrix.rows()]) {
+    for (size_t i = 0; i < _rows; i++) {
+        const float *values = matrix.begin() + i * _cols;
+        float low = 0.0f;
+        float high = 0.0f;
+        for (size_t j = 0; j < _cols; j++) {
+            low = minimum(low, values[j]);
+            high = maximum(high, values[j]);
+        }
+        const float scale = (high > low) ? ((high - low) / 255.0f) : 1.0f;
+        const float zero_point = minimum(maximum(round<float>(-low / scale), 0.0f), 255.0f);
+        for (size_t j = 0; j < _cols; j++) {
+            const float q = minimum(maximum(round<float>(values[j] / scale) + zero_point, 0.0f), 255.0f);
+            data[i * _cols + j] = static_cast<uint8_t>(q);
+        }
+        scales[i] = scale;
+        zero_points[i] = static_cast<int32_t>(zero_point);
+    }
+}
+
+Matrix<float> Quantized_Matrix::dequantize(void) const {
+    Matrix<float> matrix(_rows, _cols);
+    float *values = matrix.begin();
+    for (size_t i = 0; i < _rows; i++) {
+        for (size_t j = 0; j < _cols; j++) {
+            values[i * _cols + j] = scales[i] * static_cast<float>(static_cast<int32_t>(data[i * _cols + j]) - zero_points[i]);
+        }
+    }
+    return matrix;
+}
+
+// Quantizes the vector and computes each element as
+// scale(i) * x_scale * (dot(row(i), x) - zero_point(i) * sum(x))
+Vector<float> gemv(const Quantized_Matrix &matrix, const Vector<float> &vector) {
+    if (matrix.cols() != vector.length()) {
+        throw std::runtime_error("Multiplication of matrix and vector with incompatible lengths!");
+    }
+    const Quantized_Vector x(vector);
+    Vector<float> result(matrix.rows());
+    for (size_t i = 0; i < matrix.rows(); i++) {
+        const int64_t dot = dot_product(matrix.row(i), x.begin(), x.length()) - matrix.zero_point(i) * x.sum();
+        result[i] = matrix.scale(i) * x.scale() * static_cast<float>(dot);
+    }
+    return result;
+}
+
+// The columns of b are quantized separately, each with its own scale, so
+// both operands of every dot product are contiguous
+Matrix<float> gemm(const Quantized_Matrix &a, const Matrix<float> &b) {
+    if (a.cols() != b.rows()) {
+        throw std::runtime_error("Trying to multiply matrices with incompatible sizes!");
+    }
+    const Matrix<float> transposed = b.transpose();
+    std::vector<Quantized_Vector> columns;
+    columns.reserve(b.cols());
+    for (size_t j = 0; j < b.cols(); j++) {
+        columns.emplace_back(transposed.begin() + j * b.rows(), b.rows());
+    }
+    Matrix<float> result(a.rows(), b.cols());
+    float *c = result.begin();
+    for (size_t i = 0; i < a.rows(); i++) {
+        for (size_t j = 0; j < b.cols(); j++) {
+            const Quantized_Vector &column = columns[j];
+            const int64_t dot = dot_product(a.row(i), column.begin(), column.length()) - a.zero_point(i) * column.sum();
+            c[i * b.cols() + j] = a.scale(i) * column.scale() * static_cast<float>(dot);
+        }
+    }
+    return result;
+}
+
+#endif  // __QUANTIZED_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,211 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __RANDOM_CPP
+#define __RANDOM_CPP
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "parallel.hpp"
+#include "scalar.hpp"
+
+// Number of interleaved generators used by the fill functions, so the
+// compiler can advance them together in SIMD registers
+constexpr size_t random_lanes = 4;
+
+uint64_t rotate_left(const uint64_t value, const int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// SplitMix64, used to expand a seed into the state of the generators
+uint64_t splitmix64(uint64_t &state) {
+    state += 0x9e3779b97f4a7c15ull;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256+ by David Blackman and Sebastiano Vigna. Its upper bits are
+// of excellent quality, and only those are used to build floating point
+// numbers. Each (seed, stream) pair selects an independent sequence, so
+// threads can generate their own numbers without sharing any state
+class Random {
+   private:
+    uint64_t state[4];
+
+   public:
+    explicit Random(const uint64_t seed, const uint64_t stream = 0);
+    uint64_t next(void);
+    template <typename Floating>
+    Floating uniform(const Floating min, const Floating max);
+    template <typename Floating>
+    Floating normal(const Floating mean, const Floating deviation);
+};
+
+Random::Random(const uint64_t seed, const uint64_t stream) {
+    uint64_t mixer = seed;
+    uint64_t stream_mixer = stream;
+    mixer ^= splitmix64(stream_mixer);
+    for (auto &word : state) {
+        word = splitmix64(mixer);
+    }
+}
+
+uint64_t Random::next(void) {
+    const uint64_t result = state[0] + state[3];
+    const uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotate_left(state[3], 45);
+    return result;
+}
+
+// Maps the upper 53 bits to [0, 1) with a single multiplication
+double unit_interval(const uint64_t bits) {
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Rounding to a narrower Floating may reach max, so the result is
+// clamped to the largest number below it, keeping the range half-open
+template <typename Floating>
+Floating below_maximum(const double value, const Floating min, const Floating max) {
+    return minimum(static_cast<Floating>(value), std::nextafter(max, min));
+}
+
+template <typename Floating>
+Floating Random::uniform(const Floating min, const Floating max) {
+    return below_maximum(unit_interval(next()) * (static_cast<double>(max) - static_cast<double>(min)) + static_cast<double>(min), min, max);
+}
+
+// Box-Muller transform, discarding the second number of the pair
+template <typename Floating>
+Floating Random::normal(const Floating mean, const Floating deviation) {
+    const double radius = std::sqrt(-2.0 * std::log(1.0 - unit_interval(next())));
+    const double angle = 2.0 * const_pi * unit_interval(next());
+    return static_cast<Floating>(static_cast<double>(mean) + static_cast<double>(deviation) * radius * cosine(angle));
+}
+
+// Returns a different seed on every call, for the functions which don't
+// receive an explicit one
+uint64_t random_seed(void) {
+    static std::atomic<uint64_t> counter(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    uint64_t state = counter.fetch_add(1);
+    return splitmix64(state);
+}
+
+// Fills length values with random_lanes interleaved generators. Each chunk
+// of parallel_for gets its own streams, so the output depends only on the
+// seed, never on the number of threads
+template <typename Floating, typename Transform>
+void random_fill(Floating *output, const size_t length, const uint64_t seed, const Transform &transform) {
+    parallel_for(length, [&](const size_t begin, const size_t end) {
+        const uint64_t stream = random_lanes * (begin / parallel_chunk_length);
+        uint64_t s0[random_lanes], s1[random_lanes], s2[random_lanes], s3[random_lanes];
+        for (size_t lane = 0; lane < random_lanes; lane++) {
+            uint64_t mixer = seed;
+            uint64_t stream_mixer = stream + lane;
+            mixer ^= splitmix64(stream_mixer);
+            s0[lane] = splitmix64(mixer);
+            s1[lane] = splitmix64(mixer);
+            s2[lane] = splitmix64(mixer);
+            s3[lane] = splitmix64(mixer);
+        }
+        uint64_t bits[random_lanes];
+        for (size_t i = begin; i < end; i += random_lanes) {
+            for (size_t lane = 0; lane < random_lanes; lane++) {
+                bits[lane] = s0[lane] + s3[lane];
+                const uint64_t t = s1[lane] << 17;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = rotate_left(s3[lane], 45);
+            }
+            transform(bits, output + i, minimum(random_lanes, end - i));
+        }
+    });
+}
+
+// Uniform numbers in [min, max)
+template <typename Floating>
+void fill_uniform(Floating *output, const size_t length, const Floating min, const Floating max, const uint64_t seed) {
+    const double scale = static_cast<double>(max) - static_cast<double>(min);
+    const double offset = static_cast<double>(min);
+    random_fill(output, length, seed, [=](const uint64_t *bits, Floating *values, const size_t count) {
+        for (size_t lane = 0; lane < count; lane++) {
+            values[lane] = below_maximum(unit_interval(bits[lane]) * scale + offset, min, max);
+        }
+    });
+}
+
+// Normally distributed numbers. Box-Muller turns each pair of lanes into
+// two independent numbers
+template <typename Floating>
+void fill_normal(Floating *output, const size_t length, const Floating mean, const Floating deviation, const uint64_t seed) {
+    random_fill(output, length, seed, [=](const uint64_t *bits, Floating *values, const size_t count) {
+        for (size_t lane = 0; lane < count; lane += 2) {
+            const double radius = std::sqrt(-2.0 * std::log(1.0 - unit_interval(bits[lane])));
+            double s, c;
+            sincos(2.0 * const_pi * unit_interval(bits[lane + 1]), s, c);
+            values[lane] = static_cast<Floating>(static_cast<double>(mean) + static_cast<double>(deviation) * radius * c);
+            if (lane + 1 < count) {
+                values[lane + 1] = static_cast<Floating>(static_cast<double>(mean) + static_cast<double>(deviation) * radius * s);
+            }
+        }
+    });
+}
+
+#endif  // __RANDOM_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
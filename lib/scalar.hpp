@@ -24,7 +24,9 @@
 #define __SCALAR_CPP
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 constexpr uint64_t scalar_iterations = 10000;
 constexpr double scalar_precision = 1e-10;
@@ -38,37 +40,100 @@ void swap(Floating &a, Floating &b) {
     b = temp;
 }
 
-uint64_t factorial(uint64_t value) {
-    uint64_t result = 1;
-    while (value > 1) {
-        result = result * value;
-        value--;
+// Fixed size array which can be built and read in constant expressions,
+// so tables generated at compile time cost nothing at startup
+template <typename Type, size_t length>
+struct Constant_Table {
+    Type values[length];
+
+    constexpr Type operator[](const size_t index) const {
+        return values[index];
+    }
+
+    static constexpr size_t size(void) {
+        return length;
     }
-    return result;
+};
+
+// The indices 0, 1, ..., length - 1 as a parameter pack, to expand one
+// element of a table for each index. Built by halves, so the template
+// depth is logarithmic on the length
+template <size_t... indices>
+struct Index_List {};
+
+template <typename First, typename Second>
+struct Concatenate_Index_Lists;
+
+template <size_t... first, size_t... second>
+struct Concatenate_Index_Lists<Index_List<first...>, Index_List<second...>> {
+    typedef Index_List<first..., (sizeof...(first) + second)...> type;
+};
+
+template <size_t length>
+struct Make_Index_List {
+    typedef typename Concatenate_Index_Lists<typename Make_Index_List<length / 2>::type, typename Make_Index_List<length - length / 2>::type>::type type;
+};
+
+template <>
+struct Make_Index_List<0> {
+    typedef Index_List<> type;
+};
+
+template <>
+struct Make_Index_List<1> {
+    typedef Index_List<0> type;
+};
+
+constexpr uint64_t factorial_product(const uint64_t value) {
+    return (value > 1) ? value * factorial_product(value - 1) : 1;
+}
+
+template <size_t... indices>
+constexpr Constant_Table<uint64_t, sizeof...(indices)> make_factorial_table(Index_List<indices...>) {
+    return {{factorial_product(indices)...}};
+}
+
+template <size_t... indices>
+constexpr Constant_Table<double, sizeof...(indices)> make_inverse_factorial_table(Index_List<indices...>) {
+    return {{(1.0 / static_cast<double>(factorial_product(indices)))...}};
+}
+
+// 0! to 20!, the largest one which fits in 64 bits, and their inverses,
+// which are the coefficients of the Taylor series
+constexpr Constant_Table<uint64_t, 21> factorial_table = make_factorial_table(Make_Index_List<21>::type());
+constexpr Constant_Table<double, 21> inverse_factorial_table = make_inverse_factorial_table(Make_Index_List<21>::type());
+
+// 0! to 65!, wrapped around as unsigned products are above 20!. From 66!,
+// which has 64 factors of two, the wrapped product is always 0
+constexpr Constant_Table<uint64_t, 66> wrapped_factorial_table = make_factorial_table(Make_Index_List<66>::type());
+
+// Table lookups, without recursion at run time
+constexpr uint64_t factorial(const uint64_t value) {
+    return (value < factorial_table.size()) ? factorial_table[value] : ((value < wrapped_factorial_table.size()) ? wrapped_factorial_table[value] : 0);
 }
 
 template <typename Floating>
-bool are_close(const Floating a, const Floating b, const Floating delta) {
-    return (fabs(a - b) < delta);
+constexpr bool are_close(const Floating a, const Floating b, const Floating delta) {
+    return ((a - b) < delta) && ((b - a) < delta);
 }
 
 template <typename Floating>
-bool isNAN(const Floating value) {
+constexpr bool isNAN(const Floating value) {
     return (value != value);
 }
 
 template <typename Floating>
-Floating maximum(const Floating a, const Floating b) {
+constexpr Floating maximum(const Floating a, const Floating b) {
     return ((a > b) ? a : b);
 }
 
 template <typename Floating>
-Floating minimum(const Floating a, const Floating b) {
+constexpr Floating minimum(const Floating a, const Floating b) {
     return ((a < b) ? a : b);
 }
 
 template <typename Floating>
-Floating sign(const Floating value) {
+constexpr Floating sign(const Floating value) {
     return static_cast<Floating>((value > static_cast<Floating>(0)) ? 1.0 : -1.0);
 }
 
@@ -85,169 +150,487 @@ Floating random_number(const Floating min, const Floating max) {
     return (rand_unitary * (max - min) + min);
 }
 
-// My own square root function, so I don't need to link with -lm,
-// avoiding any dependencies
-template <typename Floating>
-Floating square_root(const Floating value) {
-    if (are_close<Floating>(value, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-        return static_cast<Floating>(0.0);  // square_root(0) = 0
-    } else if (value < static_cast<Floating>(0)) {
-        return static_cast<Floating>(NAN);
-    }
-    Floating x = value;
-    // Use the Newton-Raphson method to find the root
-    // of the function f(x) = x^2 - value
-    for (size_t k = 0; k < scalar_iterations; k++) {
-        const Floating delta = (value / x - x) / 2.0;
-        x += delta;
-        if (are_close<Floating>(delta, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-            break;
+// Splits of pi/2 and ln(2) in parts with trailing zero bits, so that their
+// products by the small integers of the range reductions below are exact
+// (Cody and Waite). Taken from fdlibm
+constexpr double half_pi_1 = 1.57079632673412561417e+00;
+constexpr double half_pi_2 = 6.07710050630396597660e-11;
+constexpr double half_pi_3 = 2.02226624871116645580e-21;
+constexpr double half_pi_3_tail = 8.47842766036889956997e-32;
+constexpr double inverse_half_pi = 6.36619772367581382433e-01;
+constexpr double ln2_high = 6.93147180369123816490e-01;
+constexpr double ln2_low = 1.90821492927058770002e-10;
+constexpr double inverse_ln2 = 1.44269504088896338700e+00;
+
+// Bits of a double as an integer, and back
+uint64_t to_bits(const double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double from_bits(const uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 2^exponent, for exponents of normal numbers, from [-1022, 1023]
+double power_of_two(const int exponent) {
+    return from_bits(static_cast<uint64_t>(1023 + exponent) << 52);
+}
+
+// value * 2^exponent, for exponents from [-2098, 2046], rounding only once
+// when the result is subnormal
+double scale_by_power_of_two(double value, int exponent) {
+    if (exponent > 1023) {
+        value *= power_of_two(1023);
+        exponent -= 1023;
+    } else if (exponent < -1022) {
+        // Scale by 2^53 too, so the last product is the only inexact one
+        value *= power_of_two(-969);
+        exponent += 969;
+        if (exponent < -1022) {
+            value *= power_of_two(-969);
+            exponent = maximum(exponent + 969, -1022);
         }
     }
-    return x;
+    return value * power_of_two(minimum(exponent, 1023));
 }
 
-// My own root function, so I don't need to link with -lm,
-// avoiding any dependencies
+// Writes value - quadrant * pi/2 as head + tail, with |head| <= pi/4, and
+// returns the quadrant modulo 4. Three steps of Cody-Waite reduction with
+// 33-bit parts of pi/2, keeping the rounding error of each subtraction, are
+// accurate while |value| < 2^20 * pi/2. Larger values are first taken
+// modulo the double nearest to 2*pi, which keeps the results bounded, but
+// not accurate
+int reduce_half_pi(double value, double &head, double &tail) {
+    if (!(fabs(value) < 1.6e6)) {
+        value = fmod(value, 2.0 * const_pi);
+    }
+    const double n = floor(value * inverse_half_pi + 0.5);
+    const double r = value - n * half_pi_1;
+    // r - n * half_pi_2 = s + e and s - n * half_pi_3 = t + f, exactly
+    const double a = n * half_pi_2;
+    const double s = r - a;
+    const double v = s - r;
+    const double e = (r - (s - v)) - (a + v);
+    const double b = n * half_pi_3;
+    const double t = s - b;
+    const double u = t - s;
+    const double f = (s - (t - u)) - (b + u);
+    const double w = n * half_pi_3_tail - (e + f);
+    head = t - w;
+    tail = (t - head) - w;
+    return static_cast<int>(n - 4.0 * floor(n * 0.25));
+}
+
+// sin(x + y) for |x + y| <= pi/4, where y is the tail of the reduced
+// argument. Minimax polynomial from fdlibm, with error below 2^-58
+double sine_kernel(const double x, const double y) {
+    const double S1 = -1.66666666666666324348e-01;
+    const double S2 = 8.33333333332248946124e-03;
+    const double S3 = -1.98412698298579493134e-04;
+    const double S4 = 2.75573137070700676789e-06;
+    const double S5 = -2.50507602534068634195e-08;
+    const double S6 = 1.58969099521155010221e-10;
+    const double z = x * x;
+    const double w = z * z;
+    const double r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+    const double v = z * x;
+    return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+// cos(x + y) for |x + y| <= pi/4. Minimax polynomial from fdlibm, with
+// error below 2^-58, and 1 - x^2/2 summed with its rounding error
+double cosine_kernel(const double x, const double y) {
+    const double C1 = 4.16666666666666019037e-02;
+    const double C2 = -1.38888888888741095749e-03;
+    const double C3 = 2.48015872894767294178e-05;
+    const double C4 = -2.75573143513906633035e-07;
+    const double C5 = 2.08757232129817482790e-09;
+    const double C6 = -1.13596475577881948265e-11;
+    const double z = x * x;
+    const double w = z * z;
+    const double r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+    const double half = 0.5 * z;
+    const double one_minus_half = 1.0 - half;
+    return one_minus_half + (((1.0 - one_minus_half) - half) + (z * r - x * y));
+}
+
+// Sine and cosine of the same angle, sharing the range reduction. The cost
+// does not depend on the input, and the results are within 1 ulp in double
+// precision while |value| < 1.6e6. Infinities and NaN give NaN
 template <typename Floating>
-Floating root(const Floating value, const uint64_t n) {
-    if (n == 1) {
-        return value;
-    } else if ((n == 0) && (are_close(value, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision)))) {
-        return static_cast<Floating>(NAN);
-    } else if (n == 0) {
-        return static_cast<Floating>(1.0);
-    } else if (are_close(value, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-        return static_cast<Floating>(0.0);  // root(0) = 0
-    } else if ((n % 2 == 0) && (value < static_cast<Floating>(0.0))) {
-        return static_cast<Floating>(NAN);
+void sincos(const Floating value, Floating &sine_value, Floating &cosine_value) {
+    const double x = static_cast<double>(value);
+    if (!(fabs(x) <= 1.79769313486231570815e+308)) {
+        sine_value = cosine_value = static_cast<Floating>(x - x);
+        return;
     }
-    Floating x = value;
-    // Use the Newton-Raphson method to find the root
-    // of the function f(x) = x^n - value
-    for (size_t k = 0; k < scalar_iterations; k++) {
-        const Floating delta = (value / power(x, (n - 1)) - x) / (static_cast<Floating>(n));
-        x += delta;
-        if (are_close<Floating>(delta, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
+    double head, tail;
+    const int quadrant = reduce_half_pi(x, head, tail);
+    const double s = sine_kernel(head, tail);
+    const double c = cosine_kernel(head, tail);
+    switch (quadrant) {
+        case 0:
+            sine_value = static_cast<Floating>(s);
+            cosine_value = static_cast<Floating>(c);
+            break;
+        case 1:
+            sine_value = static_cast<Floating>(c);
+            cosine_value = static_cast<Floating>(-s);
+            break;
+        case 2:
+            sine_value = static_cast<Floating>(-s);
+            cosine_value = static_cast<Floating>(-c);
+            break;
+        default:
+            sine_value = static_cast<Floating>(-c);
+            cosine_value = static_cast<Floating>(s);
             break;
-        }
     }
-    return x;
 }
 
-// My own power function, so I don't need to link with -lm,
+// My own sine function, so I don't need to link with -lm,
 // avoiding any dependencies
 template <typename Floating>
-Floating power(const Floating base, uint64_t expoent) {
-    Floating result = static_cast<Floating>(1.0);
-    while (expoent != 0) {
-        result *= base;
-        expoent--;
-    }
-    return result;
+Floating sine(const Floating value) {
+    Floating s, c;
+    sincos(value, s, c);
+    return s;
 }
 
-// My own exponential function, so I don't need to link with -lm,
+// My own cosine function, so I don't need to link with -lm,
 // avoiding any dependencies
 template <typename Floating>
+Floating cosine(const Floating value) {
+    Floating s, c;
+    sincos(value, s, c);
+    return c;
+}
+
+// My own tangent function, so I don't need to link with -lm,
+// avoiding any dependencies
+template <typename Floating>
+Floating tangent(const Floating value) {
+    Floating s, c;
+    sincos(value, s, c);
+    return (s / c);
+}
+
+// Taylor series of sin(x)/x - 1 and cos(x) - 1 on x2 = x^2, from the given
+// term on, with the coefficients of the inverse factorial table. Enough
+// terms for |x| <= pi/4, in constant expressions
+constexpr double sine_series(const double x2, const size_t term) {
+    return (2 * term + 1 < inverse_factorial_table.size()) ? inverse_factorial_table[2 * term + 1] - x2 * sine_series(x2, term + 1) : 0.0;
+}
+
+constexpr double cosine_series(const double x2, const size_t term) {
+    return (2 * term < inverse_factorial_table.size()) ? inverse_factorial_table[2 * term] - x2 * cosine_series(x2, term + 1) : 0.0;
+}
+
+// sin(x + y) and cos(x + y) for |x + y| <= pi/4, where y is below 1e-10
+// of x, so that only its first order term counts
+constexpr double constant_sine(const double x, const double y) {
+    return x + (y * (1.0 - (x * x) * cosine_series(x * x, 1)) - x * (x * x) * sine_series(x * x, 1));
+}
+
+// 1 - x^2/2 is summed with its rounding error, as in cosine_kernel
+constexpr double constant_cosine_sum(const double x, const double y, const double x2, const double half, const double one_minus_half) {
+    return one_minus_half + (((1.0 - one_minus_half) - half) + (x2 * x2 * cosine_series(x2, 2) - y * (x - x * x2 * sine_series(x2, 1))));
+}
+
+constexpr double constant_cosine(const double x, const double y) {
+    return constant_cosine_sum(x, y, x * x, 0.5 * (x * x), 1.0 - 0.5 * (x * x));
+}
+
+// The angle (pi/2)*index/length as head + tail. For powers of two up to
+// 2^20, the ratio has few enough bits that its product by the 33-bit head
+// of pi/2 is exact
+constexpr double table_angle(const size_t index, const size_t length) {
+    return static_cast<double>(index) / static_cast<double>(length) * half_pi_1;
+}
+
+constexpr double table_angle_tail(const size_t index, const size_t length) {
+    return static_cast<double>(index) / static_cast<double>(length) * 6.07710050650619224932e-11;
+}
+
+template <size_t... indices>
+constexpr Constant_Table<double, sizeof...(indices)> make_sine_table(Index_List<indices...>, const size_t length) {
+    return {{constant_sine(table_angle(indices, length), table_angle_tail(indices, length))...}};
+}
+
+template <size_t... indices>
+constexpr Constant_Table<double, sizeof...(indices)> make_cosine_table(Index_List<indices...>, const size_t length) {
+    return {{constant_cosine(table_angle(indices, length), table_angle_tail(indices, length))...}};
+}
+
+// Sine and cosine of (pi/2)*index/length for index from [0, length/2],
+// which covers the first octant, built at compile time. The symmetries of
+// sine and cosine give every other multiple of the angle
+template <size_t length>
+struct Sine_Table {
+    static_assert((length >= 2) && (length <= (1 << 20)) && ((length & (length - 1)) == 0), "The length of a sine table must be a power of two, up to 2^20");
+    static constexpr Constant_Table<double, length / 2 + 1> sine = make_sine_table(typename Make_Index_List<length / 2 + 1>::type(), length);
+    static constexpr Constant_Table<double, length / 2 + 1> cosine = make_cosine_table(typename Make_Index_List<length / 2 + 1>::type(), length);
+};
+
+template <size_t length>
+constexpr Constant_Table<double, length / 2 + 1> Sine_Table<length>::sine;
+
+template <size_t length>
+constexpr Constant_Table<double, length / 2 + 1> Sine_Table<length>::cosine;
+
+// My own exponential function, so I don't need to link with -lm,
+// avoiding any dependencies. value = k*ln(2) + r, with |r| <= ln(2)/2,
+// and exp(r) comes from the fdlibm rational approximation, so the cost does
+// not depend on the input and the result is within 1 ulp in double
+// precision, subnormal results included
+template <typename Floating>
 Floating exponential(const Floating value) {
-    Floating term = static_cast<Floating>(1.0);
-    Floating result = term;
-    for (uint64_t i = 1; i < scalar_iterations; i++) {
-        term *= value / (static_cast<Floating>(i));
-        result += term;
-        if (are_close<Floating>(term, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-            break;
-        }
+    const double x = static_cast<double>(value);
+    if (x != x) {
+        return value;
+    } else if (x > 7.09782712893383973096e+02) {
+        return static_cast<Floating>(INFINITY);
+    } else if (x < -7.45133219101941108420e+02) {
+        return static_cast<Floating>(0.0);
     }
-    return result;
+    const double P1 = 1.66666666666666019037e-01;
+    const double P2 = -2.77777777770155933842e-03;
+    const double P3 = 6.61375632143793436117e-05;
+    const double P4 = -1.65339022054652515390e-06;
+    const double P5 = 4.13813679705723846039e-08;
+    const double k = floor(x * inverse_ln2 + 0.5);
+    const double high = x - k * ln2_high;
+    const double low = k * ln2_low;
+    const double r = high - low;
+    const double z = r * r;
+    const double c = r - z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * P5))));
+    const double y = 1.0 - ((low - (r * c) / (2.0 - c)) - high);
+    return static_cast<Floating>(scale_by_power_of_two(y, static_cast<int>(k)));
 }
 
-// My own sine function, so I don't need to link with -lm,
-// avoiding any dependencies
+// My own power function, so I don't need to link with -lm,
+// avoiding any dependencies. Exponentiation by squaring, with O(log n)
+// products, written as a single expression so that it can also run at
+// compile time
 template <typename Floating>
-Floating sine(Floating value) {
-    value = value - static_cast<Floating>(2.0 * const_pi) * floor(value / static_cast<Floating>(2.0 * const_pi));
-    Floating term = value;
-    Floating result = term;
-    for (uint64_t i = 1; i < scalar_iterations; i++) {
-        term *= -value * value / (static_cast<Floating>((2 * i + 1) * (2 * i)));
-        result += term;
-        if (are_close<Floating>(term, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-            break;
-        }
+constexpr Floating power(const Floating base, const uint64_t expoent) {
+    return (expoent == 0) ? static_cast<Floating>(1.0) : ((expoent % 2 == 1) ? base * power(base * base, expoent / 2) : power(base * base, expoent / 2));
+}
+
+// 1/sqrt(value) for positive normal values. Subtracting half of the bits
+// from a magic constant gives a seed within 3.5%, and each Newton step
+// y*(3 - value*y^2)/2 squares the error, so four steps reach double
+// precision
+double inverse_square_root_kernel(const double value) {
+    const double half = 0.5 * value;
+    double y = from_bits(UINT64_C(0x5FE6EB50C7B537A9) - (to_bits(value) >> 1));
+    for (int i = 0; i < 4; i++) {
+        y = y * (1.5 - half * y * y);
     }
-    return result;
+    return y;
 }
 
-// My own cosine function, so I don't need to link with -lm,
-// avoiding any dependencies
+// My own square root function, so I don't need to link with -lm,
+// avoiding any dependencies. Computed as value * (1/sqrt(value)), with a last
+// correction from the exact residual, so it takes the same time for any
+// input and is within 1 ulp, and correctly rounded in nearly all cases
 template <typename Floating>
-Floating cosine(Floating value) {
-    value = value - static_cast<Floating>(2.0 * const_pi) * floor(value / static_cast<Floating>(2.0 * const_pi));
-    Floating term = static_cast<Floating>(1.0);
-    Floating result = term;
-    for (uint64_t i = 1; i < scalar_iterations; i++) {
-        term *= -value * value / (static_cast<Floating>((2 * i) * (2 * i - 1)));
-        result += term;
-        if (are_close<Floating>(term, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-            break;
-        }
+Floating square_root(const Floating value) {
+    const double x = static_cast<double>(value);
+    if ((x == 0.0) || (x != x) || (x == INFINITY)) {
+        return value;  // Keeps the sign of zero, NaN and infinity
+    } else if (x < 0.0) {
+        return static_cast<Floating>(NAN);
     }
-    return result;
+    // Subnormal values are scaled by 2^108 first
+    const bool subnormal = (x < 2.22507385850720138309e-308);
+    const double scaled = subnormal ? x * power_of_two(108) : x;
+    const double y = inverse_square_root_kernel(scaled);
+    double result = scaled * y;
+#if defined(__FMA__)
+    const double residual = std::fma(-result, result, scaled);
+#else
+    // result^2 = square + error exactly, splitting result in two halves of
+    // 26 bits (Dekker), so the residual is not lost in the rounding of
+    // result^2. Targets with FMA get the exact residual directly, and would
+    // break this by contracting the products
+    const double split = 134217729.0 * result;
+    const double high = split - (split - result);
+    const double low = result - high;
+    const double square = result * result;
+    const double error = ((high * high - square) + 2.0 * high * low) + low * low;
+    const double residual = (scaled - square) - error;
+#endif
+    result += 0.5 * y * residual;
+    return static_cast<Floating>(subnormal ? result * power_of_two(-54) : result);
 }
 
-// My own tangent function, so I don't need to link with -lm,
-// avoiding any dependencies
+// 1/sqrt(value), with the same seed and iterations of square_root, within
+// 2 ulp
 template <typename Floating>
-Floating tangent(const Floating value) {
-    return (sine(value) / cosine(value));
+Floating inverse_square_root(const Floating value) {
+    const double x = static_cast<double>(value);
+    if (x == 0.0) {
+        return static_cast<Floating>(std::signbit(x) ? -INFINITY : INFINITY);
+    } else if ((x != x) || (x < 0.0)) {
+        return static_cast<Floating>(NAN);
+    } else if (x == INFINITY) {
+        return static_cast<Floating>(0.0);
+    }
+    const bool subnormal = (x < 2.22507385850720138309e-308);
+    const double scaled = subnormal ? x * power_of_two(108) : x;
+    double y = inverse_square_root_kernel(scaled);
+    y += 0.5 * y * (1.0 - scaled * y * y);
+    return static_cast<Floating>(subnormal ? y * power_of_two(54) : y);
 }
 
-// My own arctangent function, so I don't need to link with -lm,
-// avoiding any dependencies
+// ln(value) for positive finite values, to about 1e-9. The exponent comes
+// from the bits, and the logarithm of the mantissa, taken in
+// [sqrt(1/2), sqrt(2)), from the first terms of 2*atanh((m - 1)/(m + 1))
+double logarithm_estimate(double value) {
+    int exponent = 0;
+    if (value < 2.22507385850720138309e-308) {
+        value *= power_of_two(54);
+        exponent = -54;
+    }
+    const uint64_t bits = to_bits(value);
+    exponent += static_cast<int>(bits >> 52) - 1023;
+    double mantissa = from_bits((bits & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FF0000000000000));
+    if (mantissa > 1.41421356237309504880) {
+        mantissa *= 0.5;
+        exponent++;
+    }
+    const double s = (mantissa - 1.0) / (mantissa + 1.0);
+    const double z = s * s;
+    const double series = 1.0 + z * (1.0 / 3.0 + z * (1.0 / 5.0 + z * (1.0 / 7.0 + z * (1.0 / 9.0))));
+    return static_cast<double>(exponent) * (ln2_high + ln2_low) + 2.0 * s * series;
+}
+
+// My own root function, so I don't need to link with -lm,
+// avoiding any dependencies. The seed exp(ln(value)/n) is already within
+// about 1e-9, so two Newton steps for f(x) = x^n - value are enough for
+// any n, leaving the result within about 1 ulp
 template <typename Floating>
-Floating arctangent(const Floating value) {
-    if (are_close<Floating>(fabs(value), static_cast<Floating>(1.0), static_cast<Floating>(scalar_precision))) {
-        return (sign(value) * const_pi / 4.0);
-    } else if (fabs(value) < 1.0) {
-        Floating result = value;
-        for (uint64_t i = 1; i < scalar_iterations; i++) {
-            const Floating term = static_cast<Floating>(i % 2 ? -1.0 : 1.0) * power(value, 2 * i + 1) / (static_cast<Floating>(2 * i + 1));
-            result += term;
-            if (are_close<Floating>(term, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-                break;
-            }
+Floating root(const Floating value, const uint64_t n) {
+    const double x = static_cast<double>(value);
+    if (n == 1) {
+        return value;
+    } else if (n == 0) {
+        return static_cast<Floating>((x == 0.0) ? NAN : 1.0);
+    } else if (n == 2) {
+        return square_root(value);
+    } else if ((x == 0.0) || (x != x) || (fabs(x) == INFINITY)) {
+        return ((x < 0.0) && (n % 2 == 0)) ? static_cast<Floating>(NAN) : value;
+    } else if ((n % 2 == 0) && (x < 0.0)) {
+        return static_cast<Floating>(NAN);
+    }
+    const double magnitude = fabs(x);
+    const double degree = static_cast<double>(n);
+    double y = exponential(logarithm_estimate(magnitude) / degree);
+    for (int i = 0; i < 2; i++) {
+        y -= (y - magnitude / power(y, n - 1)) / degree;
+    }
+    return static_cast<Floating>((x < 0.0) ? -y : y);
+}
+
+// arctan(value) in double precision, after fdlibm. |value| is reduced to
+// [0, 7/16) by atan(x) = atan(c) + atan((x - c)/(1 + c*x)), for c from
+// {1/2, 1, 3/2, infinity}, and the polynomial of degree 22 on the reduced
+// value is within 1 ulp, so the cost does not depend on the input
+double arctangent_kernel(const double value) {
+    const double high[] = {4.63647609000806093515e-01, 7.85398163397448278999e-01, 9.82793723247329054082e-01, 1.57079632679489655800e+00};
+    const double low[] = {2.26987774529616870924e-17, 3.06161699786838301793e-17, 1.39033110312309984516e-17, 6.12323399573676603587e-17};
+    const double T[] = {
+        3.33333333333329318027e-01,
+        -1.99999999998764832476e-01,
+        1.42857142725034663711e-01,
+        -1.11111104054623557880e-01,
+        9.09088713343650656196e-02,
+        -7.69187620504482999495e-02,
+        6.66107313738753120669e-02,
+        -5.83357013379057348645e-02,
+        4.97687799461593236017e-02,
+        -3.65315727442169155270e-02,
+        1.62858201153657823623e-02,
+    };
+    double x = fabs(value);
+    int interval = -1;
+    if (x != x) {
+        return value;
+    } else if (x >= 7.3786976294838206464e+19) {  // 2^66
+        return (value < 0.0) ? -(high[3] + low[3]) : (high[3] + low[3]);
+    } else if (x < 1.0 / 134217728.0) {  // 2^-27, where atan(x) rounds to x
+        return value;
+    } else if (x >= 0.4375) {
+        if (x < 0.6875) {
+            interval = 0;
+            x = (2.0 * x - 1.0) / (2.0 + x);
+        } else if (x < 1.1875) {
+            interval = 1;
+            x = (x - 1.0) / (x + 1.0);
+        } else if (x < 2.4375) {
+            interval = 2;
+            x = (x - 1.5) / (1.0 + 1.5 * x);
+        } else {
+            interval = 3;
+            x = -1.0 / x;
         }
-        return result;
     } else {
-        Floating result = static_cast<Floating>(const_pi / 2.0 * (value > static_cast<Floating>(1.0) ? 1.0 : -1.0));
-        for (uint64_t i = 1; i < scalar_iterations; i++) {
-            const Floating term = static_cast<Floating>(i % 2 ? -1.0 : 1.0) / (power(value, 2 * i - 1) * (static_cast<Floating>(2 * i - 1)));
-            result += term;
-            if (are_close<Floating>(term, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision))) {
-                break;
-            }
-        }
-        return result;
+        x = value;
+    }
+    const double z = x * x;
+    const double w = z * z;
+    const double odd = z * (T[0] + w * (T[2] + w * (T[4] + w * (T[6] + w * (T[8] + w * T[10])))));
+    const double even = w * (T[1] + w * (T[3] + w * (T[5] + w * (T[7] + w * T[9]))));
+    if (interval < 0) {
+        return x - x * (odd + even);
     }
+    const double result = high[interval] - ((x * (odd + even) - low[interval]) - x);
+    return (value < 0.0) ? -result : result;
 }
 
+// My own arctangent function, so I don't need to link with -lm,
+// avoiding any dependencies
+template <typename Floating>
+Floating arctangent(const Floating value) {
+    return static_cast<Floating>(arctangent_kernel(static_cast<double>(value)));
+}
+
+// Angle of the point (x, y), in [-pi, pi], following the conventions of
+// the C library for zeros of both signs and infinities. Within 2 ulp
 template <typename Floating>
 Floating atan2(const Floating y, const Floating x) {
-    const bool x_is_zero = are_close<Floating>(x, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision));
-    const bool y_is_zero = are_close<Floating>(y, static_cast<Floating>(0.0), static_cast<Floating>(scalar_precision));
-    if (x_is_zero && y_is_zero) {
-        return static_cast<Floating>(0.0);
-    } else if (x_is_zero) {
-        return (sign(y) * static_cast<Floating>(const_pi / 2.0));
-    } else if (x > static_cast<Floating>(0.0)) {
-        return arctangent(y / x);
-    } else if (y >= static_cast<Floating>(0.0)) {
-        return (arctangent(y / x) + static_cast<Floating>(const_pi));
+    const double pi_low = 1.2246467991473531772e-16;  // pi - const_pi
+    const double b = static_cast<double>(y);
+    const double a = static_cast<double>(x);
+    if ((a != a) || (b != b)) {
+        return static_cast<Floating>(a + b);
+    }
+    // Bit 0 is the sign of y, bit 1 the sign of x
+    const int signs = (std::signbit(a) ? 2 : 0) + (std::signbit(b) ? 1 : 0);
+    double result;
+    if (b == 0.0) {
+        const double angles[] = {0.0, 0.0, const_pi, const_pi};
+        result = angles[signs];
+    } else if (a == 0.0) {
+        result = const_pi / 2.0;
+    } else if (fabs(a) == INFINITY) {
+        const double angles[] = {0.0, 0.0, const_pi, const_pi};
+        const double infinite_angles[] = {const_pi / 4.0, const_pi / 4.0, 3.0 * const_pi / 4.0, 3.0 * const_pi / 4.0};
+        result = (fabs(b) == INFINITY) ? infinite_angles[signs] : angles[signs];
+    } else if (fabs(b) == INFINITY) {
+        result = const_pi / 2.0;
     } else {
-        return (arctangent(y / x) - static_cast<Floating>(const_pi));
+        const double ratio = fabs(b / a);
+        // Tiny ratios with x < 0 would lose the rounding of pi - atan
+        const double angle = ((signs >= 2) && (ratio < 8.67361737988403547206e-19)) ? 0.0 : arctangent_kernel(ratio);
+        result = (signs >= 2) ? const_pi - (angle - pi_low) : angle;
     }
+    return static_cast<Floating>((signs % 2 == 1) ? -result : result);
 }
 
 #endif  // __SCALAR_CPP
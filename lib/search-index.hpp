@@ -0,0 +1,217 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SEARCH_INDEX_CPP
+#define __SEARCH_INDEX_CPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parallel.hpp"
+#include "scalar.hpp"
+#include "vector.hpp"
+
+// Number of queries advanced together by the batched lookups, so their
+// cache misses overlap instead of being paid one after the other
+constexpr size_t search_batch_interleave = 16;
+
+// Read-only index over a sorted vector. The values are stored in
+// Eytzinger (breadth first) order: the children of node k are the nodes
+// 2k and 2k + 1, so the first levels of the tree share a few cache lines
+// and the nodes visited a few levels below can be prefetched
+template <typename Floating>
+class Search_Index {
+   private:
+    // Number of values in a cache line, which are the descendants of a
+    // node four levels below it (three for double)
+    static constexpr size_t line_values = 64 / sizeof(Floating);
+
+    size_t len;
+    std::unique_ptr<Floating[]> storage;
+    Floating *tree;  // 1-based, aligned to a cache line
+    std::unique_ptr<size_t[]> rank;
+    std::unique_ptr<Floating[]> sorted;
+
+    size_t build(const size_t node, size_t index);
+    size_t resolve(size_t node) const;
+
+   public:
+    explicit Search_Index(const Vector<Floating> &vector);
+    size_t length(void) const { return len; }
+    size_t lower_bound(const Floating key) const;
+    size_t search(const Floating key) const;
+    void lower_bound(const Floating *keys, const size_t count, size_t *result) const;
+    void search(const Floating *keys, const size_t count, size_t *result) const;
+    std::vector<size_t> lower_bound(const Vector<Floating> &keys) const;
+    std::vector<size_t> search(const Vector<Floating> &keys) const;
+};
+
+template <typename Floating>
+Search_Index<Floating>::Search_Index(const Vector<Floating> &vector)
+    : len(vector.length()), storage(new Floating[vector.length() + 1 + line_values]), rank(new size_t[vector.length() + 1]), sorted(new Floating[vector.length()]) {
+    if (!vector.is_sorted()) {
+        throw std::runtime_error("Trying to build a search index from an unsorted vector!");
+    }
+    // Places tree[1] at the start of a cache line
+    const uintptr_t address = reinterpret_cast<uintptr_t>(storage.get() + 1);
+    const uintptr_t misalignment = address % 64;
+    tree = storage.get() + ((misalignment == 0) ? 0 : (64 - misalignment) / sizeof(Floating));
+    std::copy(vector.begin(), vector.end(), sorted.get());
+    build(1, 0);
+}
+
+// In-order traversal of the implicit tree, which visits the nodes in
+// ascending order of their values
+template <typename Floating>
+size_t Search_Index<Floating>::build(const size_t node, size_t index) {
+    if (node <= len) {
+        index = build(2 * node, index);
+        tree[node] = sorted[index];
+        rank[node] = index;
+        index = build(2 * node + 1, index + 1);
+    }
+    return index;
+}
+
+// The search descends to the right while the node is smaller than the key,
+// so the answer is the last node where it went left. The trailing ones of
+// the final position count those right turns
+template <typename Floating>
+size_t Search_Index<Floating>::resolve(size_t node) const {
+    node >>= __builtin_ffsll(static_cast<long long>(~node));
+    return (node == 0) ? len : rank[node];
+}
+
+// Returns the index of the first value which isn't smaller than key,
+// or length() if there is none
+template <typename Floating>
+size_t Search_Index<Floating>::lower_bound(const Floating key) const {
+    size_t node = 1;
+    while (node <= len) {
+        // Prefetches the descendants a few levels down. Deep in the tree they
+        // are past the end, so the address is clamped to stay in the array
+        __builtin_prefetch(tree + minimum(node * line_values, len));
+        node = 2 * node + static_cast<size_t>(tree[node] < key);
+    }
+    return resolve(node);
+}
+
+// Returns the index of the closest value, as Vector::search does
+template <typename Floating>
+size_t Search_Index<Floating>::search(const Floating key) const {
+    const size_t index = lower_bound(key);
+    if (index == len) {
+        return (len == 0) ? 0 : (len - 1);
+    } else if ((index > 0) && (fabs(sorted[index - 1] - key) <= fabs(sorted[index] - key))) {
+        return index - 1;
+    }
+    return index;
+}
+
+// Batched lookup: each group of queries descends the tree level by level,
+// and long batches are split across the threads
+template <typename Floating>
+void Search_Index<Floating>::lower_bound(const Floating *keys, const size_t count, size_t *result) const {
+    parallel_for(count, [&](const size_t begin, const size_t end) {
+        size_t node[search_batch_interleave];
+        for (size_t first = begin; first < end; first += search_batch_interleave) {
+            const size_t group = minimum(search_batch_interleave, end - first);
+            for (size_t q = 0; q < group; q++) {
+                node[q] = 1;
+            }
+            // All the queries of a group take the same number of steps,
+            // give or take one, since the tree is complete
+            bool searching = (len > 0);
+            while (searching) {
+                searching = false;
+                for (size_t q = 0; q < group; q++) {
+                    if (node[q] <= len) {
+                        __builtin_prefetch(tree + minimum(node[q] * line_values, len));
+                        node[q] = 2 * node[q] + static_cast<size_t>(tree[node[q]] < keys[first + q]);
+                        searching = true;
+                    }
+                }
+            }
+            for (size_t q = 0; q < group; q++) {
+                result[first + q] = resolve(node[q]);
+            }
+        }
+    });
+}
+
+template <typename Floating>
+void Search_Index<Floating>::search(const Floating *keys, const size_t count, size_t *result) const {
+    lower_bound(keys, count, result);
+    parallel_for(count, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const size_t index = result[i];
+            if (index == len) {
+                result[i] = (len == 0) ? 0 : (len - 1);
+            } else if ((index > 0) && (fabs(sorted[index - 1] - keys[i]) <= fabs(sorted[index] - keys[i]))) {
+                result[i] = index - 1;
+            }
+        }
+    });
+}
+
+template <typename Floating>
+std::vector<size_t> Search_Index<Floating>::lower_bound(const Vector<Floating> &keys) const {
+    std::vector<size_t> result(keys.length());
+    lower_bound(keys.begin(), keys.length(), result.data());
+    return result;
+}
+
+template <typename Floating>
+std::vector<size_t> Search_Index<Floating>::search(const Vector<Floating> &keys) const {
+    std::vector<size_t> result(keys.length());
+    search(keys.begin(), keys.length(), result.data());
+    return result;
+}
+
+#endif  // __SEARCH_INDEX_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,317 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SEGMENTED_ARRAY_CPP
+#define __SEGMENTED_ARRAY_CPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "dynamic-array.hpp"
+
+constexpr size_t segmented_array_chunk_length = 1 << 10;
+
+// Array which grows by adding chunks of chunk_length elements, listed in a
+// directory. The element at index is in the chunk index / chunk_length, so
+// indexing stays O(1), with a shift and a mask. Growing allocates one more
+// chunk and never moves the elements, so their addresses stay valid for as
+// long as they are in the array. The chunks emptied by pop, or added by
+// reserve, are kept as spare room until shrink_to_fit. Only the directory,
+// of one pointer per chunk, is reallocated
+template <typename Number, size_t chunk_length = segmented_array_chunk_length>
+class Segmented_Array {
+   private:
+    static_assert((chunk_length != 0) && ((chunk_length & (chunk_length - 1)) == 0), "The chunk length of a segmented array must be a power of two");
+    static_assert(alignof(Number) <= alignof(std::max_align_t), "Segmented_Array allocates with malloc, which does not support over-aligned types");
+
+    Dynamic_Array<Number *> chunks;
+    size_t len;
+
+    Number *slot(const size_t index) const { return chunks.begin()[index / chunk_length] + index % chunk_length; }
+    void add_chunk(void);
+    void destroy_all(void);
+    void free_chunks(const size_t kept);
+
+   public:
+    Segmented_Array(void) : len(0) {}
+    Segmented_Array(const Segmented_Array &to_copy);
+    Segmented_Array(Segmented_Array &&to_move);
+    ~Segmented_Array(void);
+    Segmented_Array &operator=(const Segmented_Array &to_copy);
+    Segmented_Array &operator=(Segmented_Array &&to_move);
+    std::string to_string(void) const;
+    size_t length(void) const { return len; }
+    size_t capacity(void) const { return chunks.length() * chunk_length; }
+    void reserve(const size_t capacity);
+    void shrink_to_fit(void);
+    template <typename... Arguments>
+    Number &emplace_back(Arguments &&...arguments);
+    void push(const Number &value);
+    void push(Number &&value);
+    Number pop(void);
+    Number value_at(const size_t index) const;
+    size_t find(const Number &value) const;
+    Number &operator[](const size_t index) const;
+
+    // Iterators
+    template <bool Const>
+    class Segment_Iterator;
+    Segment_Iterator<false> begin(void) { return Segment_Iterator<false>(this, 0); }
+    Segment_Iterator<false> end(void) { return Segment_Iterator<false>(this, len); }
+    Segment_Iterator<true> begin(void) const { return Segment_Iterator<true>(this, 0); }
+    Segment_Iterator<true> end(void) const { return Segment_Iterator<true>(this, len); }
+};
+
+// Holds the array and an index, so it stays valid while the array grows
+template <typename Number, size_t chunk_length>
+template <bool Const>
+class Segmented_Array<Number, chunk_length>::Segment_Iterator {
+   private:
+    typedef typename std::conditional<Const, const Segmented_Array, Segmented_Array>::type Array;
+    typedef typename std::conditional<Const, const Number, Number>::type Element;
+
+    Array *array;
+    size_t index;
+
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Number value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Element *pointer;
+    typedef Element &reference;
+
+    Segment_Iterator(Array *array, const size_t index) : array(array), index(index) {}
+    Element &operator*(void) const { return *array->slot(index); }
+    Element *operator->(void) const { return &**this; }
+    Segment_Iterator &operator++(void) {
+        index++;
+        return *this;
+    }
+    Segment_Iterator operator++(int) {
+        Segment_Iterator previous = *this;
+        index++;
+        return previous;
+    }
+    bool operator!=(const Segment_Iterator &it) const { return (index != it.index); }
+    bool operator==(const Segment_Iterator &it) const { return (index == it.index); }
+};
+
+template <typename Number, size_t chunk_length>
+Segmented_Array<Number, chunk_length>::Segmented_Array(const Segmented_Array<Number, chunk_length> &to_copy) : Segmented_Array() {
+    reserve(to_copy.len);
+    for (const Number &value : to_copy) {
+        push(value);
+    }
+}
+
+template <typename Number, size_t chunk_length>
+Segmented_Array<Number, chunk_length>::Segmented_Array(Segmented_Array<Number, chunk_length> &&to_move) : chunks(std::move(to_move.chunks)), len(to_move.len) {
+    to_move.len = 0;
+}
+
+template <typename Number, size_t chunk_length>
+Segmented_Array<Number, chunk_length>::~Segmented_Array(void) {
+    destroy_all();
+    free_chunks(0);
+}
+
+template <typename Number, size_t chunk_length>
+Segmented_Array<Number, chunk_length> &Segmented_Array<Number, chunk_length>::operator=(const Segmented_Array<Number, chunk_length> &to_copy) {
+    if (this != &to_copy) {
+        *this = Segmented_Array<Number, chunk_length>(to_copy);
+    }
+    return *this;
+}
+
+template <typename Number, size_t chunk_length>
+Segmented_Array<Number, chunk_length> &Segmented_Array<Number, chunk_length>::operator=(Segmented_Array<Number, chunk_length> &&to_move) {
+    if (this != &to_move) {
+        destroy_all();
+        free_chunks(0);
+        chunks = std::move(to_move.chunks);
+        len = to_move.len;
+        to_move.len = 0;
+    }
+    return *this;
+}
+
+template <typename Number, size_t chunk_length>
+std::ostream &operator<<(std::ostream &os, const Segmented_Array<Number, chunk_length> &array) {
+    return os << array.to_string();
+}
+
+template <typename Number, size_t chunk_length>
+std::string Segmented_Array<Number, chunk_length>::to_string(void) const {
+    std::ostringstream strs;
+    strs << "Array length: " << len << ", capacity: " << capacity() << ", chunks: " << chunks.length() << std::endl;
+    for (size_t i = 0; i < len; i++) {
+        strs << "[" << std::setw(3) << i << "]: " << (*this)[i] << std::endl;
+    }
+    return strs.str();
+}
+
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::add_chunk(void) {
+    // Room in the directory first, so that a failure leaks nothing
+    chunks.reserve(chunks.length() + 1);
+    Number *chunk = static_cast<Number *>(std::malloc(chunk_length * sizeof(Number)));
+    if (chunk == nullptr) {
+        throw std::bad_alloc();
+    }
+    chunks.push(chunk);
+}
+
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::destroy_all(void) {
+    for (size_t i = 0; i < len; i++) {
+        slot(i)->~Number();
+    }
+    len = 0;
+}
+
+// Releases the chunks after the first kept ones
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::free_chunks(const size_t kept) {
+    while (chunks.length() > kept) {
+        std::free(chunks.pop());
+    }
+}
+
+// Allocates the chunks for capacity elements
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::reserve(const size_t capacity) {
+    chunks.reserve((capacity + chunk_length - 1) / chunk_length);
+    while (this->capacity() < capacity) {
+        add_chunk();
+    }
+}
+
+// Releases the chunks which hold no elements
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::shrink_to_fit(void) {
+    free_chunks((len + chunk_length - 1) / chunk_length);
+    chunks.shrink_to_fit();
+}
+
+// Constructs the new element in place from the arguments. Growing does
+// not move the elements, so the arguments may refer to them
+template <typename Number, size_t chunk_length>
+template <typename... Arguments>
+Number &Segmented_Array<Number, chunk_length>::emplace_back(Arguments &&...arguments) {
+    if (len == capacity()) {
+        add_chunk();
+    }
+    Number *element = slot(len);
+    new (element) Number(std::forward<Arguments>(arguments)...);
+    len++;
+    return *element;
+}
+
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::push(const Number &value) {
+    emplace_back(value);
+}
+
+template <typename Number, size_t chunk_length>
+void Segmented_Array<Number, chunk_length>::push(Number &&value) {
+    emplace_back(std::move(value));
+}
+
+// The chunks are kept, for the next pushes
+template <typename Number, size_t chunk_length>
+Number Segmented_Array<Number, chunk_length>::pop(void) {
+    if (len == 0) {
+        throw std::runtime_error("Trying to pop an empty array!");
+    }
+    len--;
+    Number *last = slot(len);
+    Number value(std::move(*last));
+    last->~Number();
+    return value;
+}
+
+template <typename Number, size_t chunk_length>
+Number Segmented_Array<Number, chunk_length>::value_at(const size_t index) const {
+    if (index >= len) {
+        throw std::runtime_error("Trying to access the array in invalid range!");
+    }
+    return *slot(index);
+}
+
+template <typename Number, size_t chunk_length>
+size_t Segmented_Array<Number, chunk_length>::find(const Number &value) const {
+    // Sequential search, one chunk at a time
+    for (size_t start = 0; start < len; start += chunk_length) {
+        const Number *chunk = slot(start);
+        const size_t count = (len - start < chunk_length) ? len - start : chunk_length;
+        for (size_t i = 0; i < count; i++) {
+            if (chunk[i] == value) {
+                return start + i;
+            }
+        }
+    }
+    throw std::runtime_error("Didn't found the requested value in the array!");
+}
+
+template <typename Number, size_t chunk_length>
+Number &Segmented_Array<Number, chunk_length>::operator[](const size_t index) const {
+    if (index >= len) {
+        throw std::runtime_error("Trying to access segmented array in invalid range!");
+    }
+    return *slot(index);
+}
+
+#endif  // __SEGMENTED_ARRAY_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
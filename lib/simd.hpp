@@ -0,0 +1,282 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SIMD_CPP
+#define __SIMD_CPP
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Thin wrapper over the widest vector registers the compiler was allowed to
+// use, so element-wise kernels can be written once. Simd<Floating>::width
+// values are processed per operation: AVX holds 4 doubles or 8 floats,
+// SSE2 2 doubles or 4 floats, and without either the generic version
+// holds a single value. Comparisons return masks, which are only meant to
+// be consumed by select and any.
+template <typename Floating>
+struct Simd {
+    static constexpr size_t width = 1;
+    typedef bool Mask;
+    Floating value;
+
+    Simd(void) : value(0) {}
+    Simd(const Floating value) : value(value) {}
+    static Simd load(const Floating *address) { return Simd(*address); }
+    void store(Floating *address) const { *address = value; }
+    Simd operator+(const Simd b) const { return Simd(value + b.value); }
+    Simd operator-(const Simd b) const { return Simd(value - b.value); }
+    Simd operator*(const Simd b) const { return Simd(value * b.value); }
+    Simd operator/(const Simd b) const { return Simd(value / b.value); }
+    Simd operator-(void) const { return Simd(-value); }
+    Mask operator<(const Simd b) const { return value < b.value; }
+    static bool any(const Mask mask) { return mask; }
+    friend Simd sqrt(const Simd a) { return Simd(std::sqrt(a.value)); }
+    friend Simd abs(const Simd a) { return Simd(std::fabs(a.value)); }
+    friend Simd round(const Simd a) { return Simd(std::nearbyint(a.value)); }
+    friend Simd min(const Simd a, const Simd b) { return Simd((a.value < b.value) ? a.value : b.value); }
+    friend Simd max(const Simd a, const Simd b) { return Simd((a.value > b.value) ? a.value : b.value); }
+    friend Simd select(const Mask mask, const Simd a, const Simd b) { return mask ? a : b; }
+    friend Simd copy_sign(const Simd magnitude, const Simd sign) { return Simd(std::copysign(magnitude.value, sign.value)); }
+};
+
+#if defined(__AVX__)
+
+template <>
+struct Simd<double> {
+    static constexpr size_t width = 4;
+    typedef __m256d Mask;
+    __m256d value;
+
+    Simd(void) : value(_mm256_setzero_pd()) {}
+    Simd(const __m256d value) : value(value) {}
+    Simd(const double value) : value(_mm256_set1_pd(value)) {}
+    static Simd load(const double *address) { return Simd(_mm256_loadu_pd(address)); }
+    void store(double *address) const { _mm256_storeu_pd(address, value); }
+    Simd operator+(const Simd b) const { return Simd(_mm256_add_pd(value, b.value)); }
+    Simd operator-(const Simd b) const { return Simd(_mm256_sub_pd(value, b.value)); }
+    Simd operator*(const Simd b) const { return Simd(_mm256_mul_pd(value, b.value)); }
+    Simd operator/(const Simd b) const { return Simd(_mm256_div_pd(value, b.value)); }
+    Simd operator-(void) const { return Simd(_mm256_xor_pd(value, _mm256_set1_pd(-0.0))); }
+    Mask operator<(const Simd b) const { return _mm256_cmp_pd(value, b.value, _CMP_LT_OQ); }
+    static bool any(const Mask mask) { return _mm256_movemask_pd(mask) != 0; }
+    friend Simd sqrt(const Simd a) { return Simd(_mm256_sqrt_pd(a.value)); }
+    friend Simd abs(const Simd a) { return Simd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.value)); }
+    friend Simd round(const Simd a) { return Simd(_mm256_round_pd(a.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)); }
+    friend Simd min(const Simd a, const Simd b) { return Simd(_mm256_min_pd(a.value, b.value)); }
+    friend Simd max(const Simd a, const Simd b) { return Simd(_mm256_max_pd(a.value, b.value)); }
+    friend Simd select(const Mask mask, const Simd a, const Simd b) { return Simd(_mm256_blendv_pd(b.value, a.value, mask)); }
+    friend Simd copy_sign(const Simd magnitude, const Simd sign) {
+        const __m256d sign_bit = _mm256_set1_pd(-0.0);
+        return Simd(_mm256_or_pd(_mm256_andnot_pd(sign_bit, magnitude.value), _mm256_and_pd(sign_bit, sign.value)));
+    }
+};
+
+template <>
+struct Simd<float> {
+    static constexpr size_t width = 8;
+    typedef __m256 Mask;
+    __m256 value;
+
+    Simd(void) : value(_mm256_setzero_ps()) {}
+    Simd(const __m256 value) : value(value) {}
+    Simd(const float value) : value(_mm256_set1_ps(value)) {}
+    static Simd load(const float *address) { return Simd(_mm256_loadu_ps(address)); }
+    void store(float *address) const { _mm256_storeu_ps(address, value); }
+    Simd operator+(const Simd b) const { return Simd(_mm256_add_ps(value, b.value)); }
+    Simd operator-(const Simd b) const { return Simd(_mm256_sub_ps(value, b.value)); }
+    Simd operator*(const Simd b) const { return Simd(_mm256_mul_ps(value, b.value)); }
+    Simd operator/(const Simd b) const { return Simd(_mm256_div_ps(value, b.value)); }
+    Simd operator-(void) const { return Simd(_mm256_xor_ps(value, _mm256_set1_ps(-0.0f))); }
+    Mask operator<(const Simd b) const { return _mm256_cmp_ps(value, b.value, _CMP_LT_OQ); }
+    static bool any(const Mask mask) { return _mm256_movemask_ps(mask) != 0; }
+    friend Simd sqrt(const Simd a) { return Simd(_mm256_sqrt_ps(a.value)); }
+    friend Simd abs(const Simd a) { return Simd(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.value)); }
+    friend Simd round(const Simd a) { return Simd(_mm256_round_ps(a.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)); }
+    friend Simd min(const Simd a, const Simd b) { return Simd(_mm256_min_ps(a.value, b.value)); }
+    friend Simd max(const Simd a, const Simd b) { return Simd(_mm256_max_ps(a.value, b.value)); }
+    friend Simd select(const Mask mask, const Simd a, const Simd b) { return Simd(_mm256_blendv_ps(b.value, a.value, mask)); }
+    friend Simd copy_sign(const Simd magnitude, const Simd sign) {
+        const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+        return Simd(_mm256_or_ps(_mm256_andnot_ps(sign_bit, magnitude.value), _mm256_and_ps(sign_bit, sign.value)));
+    }
+};
+
+#elif defined(__SSE2__)
+
+template <>
+struct Simd<double> {
+    static constexpr size_t width = 2;
+    typedef __m128d Mask;
+    __m128d value;
+
+    Simd(void) : value(_mm_setzero_pd()) {}
+    Simd(const __m128d value) : value(value) {}
+    Simd(const double value) : value(_mm_set1_pd(value)) {}
+    static Simd load(const double *address) { return Simd(_mm_loadu_pd(address)); }
+    void store(double *address) const { _mm_storeu_pd(address, value); }
+    Simd operator+(const Simd b) const { return Simd(_mm_add_pd(value, b.value)); }
+    Simd operator-(const Simd b) const { return Simd(_mm_sub_pd(value, b.value)); }
+    Simd operator*(const Simd b) const { return Simd(_mm_mul_pd(value, b.value)); }
+    Simd operator/(const Simd b) const { return Simd(_mm_div_pd(value, b.value)); }
+    Simd operator-(void) const { return Simd(_mm_xor_pd(value, _mm_set1_pd(-0.0))); }
+    Mask operator<(const Simd b) const { return _mm_cmplt_pd(value, b.value); }
+    static bool any(const Mask mask) { return _mm_movemask_pd(mask) != 0; }
+    friend Simd sqrt(const Simd a) { return Simd(_mm_sqrt_pd(a.value)); }
+    friend Simd abs(const Simd a) { return Simd(_mm_andnot_pd(_mm_set1_pd(-0.0), a.value)); }
+    friend Simd round(const Simd a) {
+        // SSE2 has no rounding instruction, but adding and subtracting 1.5 * 2^52
+        // rounds values below 2^51 to the nearest integer
+        const __m128d magic = _mm_set1_pd(6755399441055744.0);
+        return Simd(_mm_sub_pd(_mm_add_pd(a.value, magic), magic));
+    }
+    friend Simd min(const Simd a, const Simd b) { return Simd(_mm_min_pd(a.value, b.value)); }
+    friend Simd max(const Simd a, const Simd b) { return Simd(_mm_max_pd(a.value, b.value)); }
+    friend Simd select(const Mask mask, const Simd a, const Simd b) { return Simd(_mm_or_pd(_mm_and_pd(mask, a.value), _mm_andnot_pd(mask, b.value))); }
+    friend Simd copy_sign(const Simd magnitude, const Simd sign) {
+        const __m128d sign_bit = _mm_set1_pd(-0.0);
+        return Simd(_mm_or_pd(_mm_andnot_pd(sign_bit, magnitude.value), _mm_and_pd(sign_bit, sign.value)));
+    }
+};
+
+template <>
+struct Simd<float> {
+    static constexpr size_t width = 4;
+    typedef __m128 Mask;
+    __m128 value;
+
+    Simd(void) : value(_mm_setzero_ps()) {}
+    Simd(const __m128 value) : value(value) {}
+    Simd(const float value) : value(_mm_set1_ps(value)) {}
+    static Simd load(const float *address) { return Simd(_mm_loadu_ps(address)); }
+    void store(float *address) const { _mm_storeu_ps(address, value); }
+    Simd operator+(const Simd b) const { return Simd(_mm_add_ps(value, b.value)); }
+    Simd operator-(const Simd b) const { return Simd(_mm_sub_ps(value, b.value)); }
+    Simd operator*(const Simd b) const { return Simd(_mm_mul_ps(value, b.value)); }
+    Simd operator/(const Simd b) const { return Simd(_mm_div_ps(value, b.value)); }
+    Simd operator-(void) const { return Simd(_mm_xor_ps(value, _mm_set1_ps(-0.0f))); }
+    Mask operator<(const Simd b) const { return _mm_cmplt_ps(value, b.value); }
+    static bool any(const Mask mask) { return _mm_movemask_ps(mask) != 0; }
+    friend Simd sqrt(const Simd a) { return Simd(_mm_sqrt_ps(a.value)); }
+    friend Simd abs(const Simd a) { return Simd(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.value)); }
+    friend Simd round(const Simd a) {
+        // Same as for doubles, valid below 2^22
+        const __m128 magic = _mm_set1_ps(12582912.0f);
+        return Simd(_mm_sub_ps(_mm_add_ps(a.value, magic), magic));
+    }
+    friend Simd min(const Simd a, const Simd b) { return Simd(_mm_min_ps(a.value, b.value)); }
+    friend Simd max(const Simd a, const Simd b) { return Simd(_mm_max_ps(a.value, b.value)); }
+    friend Simd select(const Mask mask, const Simd a, const Simd b) { return Simd(_mm_or_ps(_mm_and_ps(mask, a.value), _mm_andnot_ps(mask, b.value))); }
+    friend Simd copy_sign(const Simd magnitude, const Simd sign) {
+        const __m128 sign_bit = _mm_set1_ps(-0.0f);
+        return Simd(_mm_or_ps(_mm_andnot_ps(sign_bit, magnitude.value), _mm_and_ps(sign_bit, sign.value)));
+    }
+};
+
+#endif
+
+// a * b + c, fused when the target has FMA
+template <typename Floating>
+Simd<Floating> multiply_add(const Simd<Floating> a, const Simd<Floating> b, const Simd<Floating> c) {
+    return a * b + c;
+}
+
+// 2^exponent, for integral exponents of normal numbers, built directly in
+// the exponent bits
+template <typename Floating>
+Simd<Floating> power_of_two(const Simd<Floating> exponent) {
+    return Simd<Floating>(static_cast<Floating>(std::ldexp(1.0, static_cast<int>(exponent.value))));
+}
+
+#if defined(__AVX__)
+template <>
+Simd<double> power_of_two(const Simd<double> exponent) {
+    const __m128i biased = _mm_add_epi32(_mm256_cvtpd_epi32(exponent.value), _mm_set1_epi32(1023));
+    const __m128i low = _mm_slli_epi64(_mm_unpacklo_epi32(biased, _mm_setzero_si128()), 52);
+    const __m128i high = _mm_slli_epi64(_mm_unpackhi_epi32(biased, _mm_setzero_si128()), 52);
+    return Simd<double>(_mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1)));
+}
+
+template <>
+Simd<float> power_of_two(const Simd<float> exponent) {
+    const __m256i integer = _mm256_cvtps_epi32(exponent.value);
+    const __m128i bias = _mm_set1_epi32(127);
+    const __m128i low = _mm_slli_epi32(_mm_add_epi32(_mm256_castsi256_si128(integer), bias), 23);
+    const __m128i high = _mm_slli_epi32(_mm_add_epi32(_mm256_extractf128_si256(integer, 1), bias), 23);
+    return Simd<float>(_mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1)));
+}
+#elif defined(__SSE2__)
+template <>
+Simd<double> power_of_two(const Simd<double> exponent) {
+    const __m128i biased = _mm_add_epi32(_mm_cvtpd_epi32(exponent.value), _mm_set1_epi32(1023));
+    return Simd<double>(_mm_castsi128_pd(_mm_slli_epi64(_mm_unpacklo_epi32(biased, _mm_setzero_si128()), 52)));
+}
+
+template <>
+Simd<float> power_of_two(const Simd<float> exponent) {
+    const __m128i biased = _mm_add_epi32(_mm_cvtps_epi32(exponent.value), _mm_set1_epi32(127));
+    return Simd<float>(_mm_castsi128_ps(_mm_slli_epi32(biased, 23)));
+}
+#endif
+
+#if defined(__FMA__) && defined(__AVX__)
+template <>
+Simd<double> multiply_add(const Simd<double> a, const Simd<double> b, const Simd<double> c) {
+    return Simd<double>(_mm256_fmadd_pd(a.value, b.value, c.value));
+}
+
+template <>
+Simd<float> multiply_add(const Simd<float> a, const Simd<float> b, const Simd<float> c) {
+    return Simd<float>(_mm256_fmadd_ps(a.value, b.value, c.value));
+}
+#endif
+
+#endif  // __SIMD_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
@@ -0,0 +1,318 @@
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __SORT_CPP
+#define __SORT_CPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "parallel.hpp"
+#include "scalar.hpp"
+
+// Runs shorter than this are finished with insertion sort
+constexpr size_t insertion_sort_threshold = 24;
+// Digit size of the radix sort, in bits
+constexpr size_t radix_bits = 8;
+constexpr size_t radix_buckets = 1 << radix_bits;
+
+// Strict weak ordering in which NaNs are greater than every number,
+// so they are gathered at the end and never break the partitioning
+template <typename Floating>
+bool sort_less(const Floating a, const Floating b) {
+    return (a < b) || (!isNAN(a) && isNAN(b));
+}
+
+template <typename Floating>
+void insertion_sort(Floating *array, const size_t length) {
+    for (size_t i = 1; i < length; i++) {
+        const Floating value = array[i];
+        size_t j = i;
+        for (; (j > 0) && sort_less(value, array[j - 1]); j--) {
+            array[j] = array[j - 1];
+        }
+        array[j] = value;
+    }
+}
+
+template <typename Floating>
+void sift_down(Floating *array, size_t root, const size_t length) {
+    const Floating value = array[root];
+    for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1) {
+        if ((child + 1 < length) && sort_less(array[child], array[child + 1])) {
+            child++;
+        }
+        if (!sort_less(value, array[child])) {
+            break;
+        }
+        array[root] = array[child];
+        root = child;
+    }
+    array[root] = value;
+}
+
+template <typename Floating>
+void heap_sort(Floating *array, const size_t length) {
+    for (size_t i = length / 2; i > 0; i--) {
+        sift_down(array, i - 1, length);
+    }
+    for (size_t end = length; end > 1; end--) {
+        swap<Floating>(array[0], array[end - 1]);
+        sift_down(array, 0, end - 1);
+    }
+}
+
+// Moves the median of the first, middle and last elements to the first
+// position, so it can be used as pivot
+template <typename Floating>
+void median_of_three(Floating *array, const size_t length) {
+    Floating &a = array[0];
+    Floating &b = array[length / 2];
+    Floating &c = array[length - 1];
+    if (sort_less(b, a)) {
+        swap<Floating>(a, b);
+    }
+    if (sort_less(c, b)) {
+        swap<Floating>(b, c);
+        if (sort_less(b, a)) {
+            swap<Floating>(a, b);
+        }
+    }
+    swap<Floating>(a, b);
+}
+
+// Hoare partition around array[0]. Returns the final position of the pivot
+template <typename Floating>
+size_t partition(Floating *array, const size_t length) {
+    const Floating pivot = array[0];
+    size_t i = 0;
+    size_t j = length;
+    for (;;) {
+        do {
+            i++;
+        } while ((i < length) && sort_less(array[i], pivot));
+        do {
+            j--;
+        } while (sort_less(pivot, array[j]));
+        if (i >= j) {
+            break;
+        }
+        swap<Floating>(array[i], array[j]);
+    }
+    swap<Floating>(array[0], array[j]);
+    return j;
+}
+
+template <typename Floating>
+void introsort_loop(Floating *array, size_t length, size_t depth) {
+    while (length > insertion_sort_threshold) {
+        if (depth == 0) {
+            heap_sort(array, length);
+            return;
+        }
+        depth--;
+        median_of_three(array, length);
+        const size_t middle = partition(array, length);
+        // Recurse into the smaller side, so the stack depth is O(log n)
+        if (middle < length - middle) {
+            introsort_loop(array, middle, depth);
+            array += middle + 1;
+            length -= middle + 1;
+        } else {
+            introsort_loop(array + middle + 1, length - middle - 1, depth);
+            length = middle;
+        }
+    }
+    insertion_sort(array, length);
+}
+
+// Quicksort with median of three pivots, which falls back to heapsort when
+// the recursion gets too deep, so the worst case is O(n log n)
+template <typename Floating>
+void introsort(Floating *array, const size_t length) {
+    size_t depth = 0;
+    for (size_t n = length; n > 1; n /= 2) {
+        depth += 2;
+    }
+    introsort_loop(array, length, depth);
+}
+
+template <typename Floating>
+struct Radix_Key;
+
+template <>
+struct Radix_Key<float> {
+    typedef uint32_t type;
+};
+
+template <>
+struct Radix_Key<double> {
+    typedef uint64_t type;
+};
+
+// Maps the bits of a floating point number to an unsigned integer with the
+// same ordering: negative numbers have all bits flipped, positive numbers
+// only the sign bit. So -0.0 is placed just before +0.0
+template <typename Floating>
+typename Radix_Key<Floating>::type radix_key(const Floating value) {
+    typedef typename Radix_Key<Floating>::type Key;
+    constexpr Key sign_bit = static_cast<Key>(1) << (8 * sizeof(Key) - 1);
+    Key bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & sign_bit) ? static_cast<Key>(~bits) : static_cast<Key>(bits | sign_bit);
+}
+
+// LSD radix sort for float and double. NaNs are moved to the end of the
+// array with their bits untouched. Passes whose digit is the same for all
+// the elements are skipped
+template <typename Floating>
+void radix_sort(Floating *array, size_t length) {
+    typedef typename Radix_Key<Floating>::type Key;
+    constexpr size_t digits = 8 * sizeof(Key) / radix_bits;
+    size_t numbers = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (!isNAN(array[i])) {
+            swap<Floating>(array[numbers], array[i]);
+            numbers++;
+        }
+    }
+    length = numbers;
+    if (length < 2) {
+        return;
+    }
+    std::unique_ptr<size_t[]> histogram(new size_t[digits * radix_buckets]());
+    for (size_t i = 0; i < length; i++) {
+        const Key key = radix_key(array[i]);
+        for (size_t d = 0; d < digits; d++) {
+            histogram[d * radix_buckets + ((key >> (d * radix_bits)) & (radix_buckets - 1))]++;
+        }
+    }
+    std::unique_ptr<Floating[]> buffer(new Floating[length]);
+    Floating *from = array;
+    Floating *to = buffer.get();
+    for (size_t d = 0; d < digits; d++) {
+        size_t *count = &histogram[d * radix_buckets];
+        const Key first_digit = (radix_key(from[0]) >> (d * radix_bits)) & (radix_buckets - 1);
+        if (count[first_digit] == length) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t b = 0; b < radix_buckets; b++) {
+            const size_t n = count[b];
+            count[b] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < length; i++) {
+            const Key key = radix_key(from[i]);
+            to[count[(key >> (d * radix_bits)) & (radix_buckets - 1)]++] = from[i];
+        }
+        swap<Floating *>(from, to);
+    }
+    if (from != array) {
+        memcpy(array, from, length * sizeof(Floating));
+    }
+}
+
+template <typename Floating>
+void merge_runs(const Floating *left, const size_t left_length, const Floating *right, const size_t right_length, Floating *output) {
+    size_t i = 0;
+    size_t j = 0;
+    while ((i < left_length) && (j < right_length)) {
+        // Takes from the left run on ties, so the merge is stable
+        if (sort_less(right[j], left[i])) {
+            *output++ = right[j++];
+        } else {
+            *output++ = left[i++];
+        }
+    }
+    while (i < left_length) {
+        *output++ = left[i++];
+    }
+    while (j < right_length) {
+        *output++ = right[j++];
+    }
+}
+
+// Splits the array in one run per thread, sorts the runs in parallel
+// with introsort and then merges pairs of runs in parallel rounds
+template <typename Floating>
+void parallel_sort(Floating *array, const size_t length) {
+    Thread_Pool &pool = parallel_pool();
+    if ((length < parallel_policy().threshold) || (pool.threads() == 1)) {
+        introsort(array, length);
+        return;
+    }
+    size_t runs = 1;
+    while (runs < pool.threads()) {
+        runs *= 2;
+    }
+    const size_t run_length = (length + runs - 1) / runs;
+    const auto run_begin = [&](const size_t run) { return minimum(run * run_length, length); };
+    pool.run(runs, [&](const size_t run) {
+        introsort(array + run_begin(run), run_begin(run + 1) - run_begin(run));
+    });
+    std::unique_ptr<Floating[]> buffer(new Floating[length]);
+    Floating *from = array;
+    Floating *to = buffer.get();
+    for (size_t width = 1; width < runs; width *= 2) {
+        pool.run(runs / (2 * width), [&](const size_t pair) {
+            const size_t begin = run_begin(2 * pair * width);
+            const size_t middle = run_begin((2 * pair + 1) * width);
+            const size_t end = run_begin((2 * pair + 2) * width);
+            merge_runs(from + begin, middle - begin, from + middle, end - middle, to + begin);
+        });
+        swap<Floating *>(from, to);
+    }
+    if (from != array) {
+        std::copy(from, from + length, array);
+    }
+}
+
+#endif  // __SORT_CPP
+
+//------------------------------------------------------------------------------
+// END
+//------------------------------------------------------------------------------
+
+// MIT License
+
+// Copyright (c) 2022 CLECIO JUNG <clecio.jung@gmail.com>
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
\ No newline at end of file
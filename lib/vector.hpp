@@ -28,22 +28,34 @@
 #include <iostream>
 #include <sstream>
 
+#include "parallel.hpp"
+#include "random.hpp"
 #include "scalar.hpp"
+#include "sort.hpp"
 
 constexpr double vector_precision = 1e-8;
+// Vectors up to this length are stored inside the object itself, so
+// short vectors, such as the 3D ones, never allocate memory
+constexpr size_t vector_inline_capacity = 4;
 
 template <typename Floating>
 class Vector {
    private:
     Floating *data;
     size_t len;
+    size_t _capacity;
+    Floating local[vector_inline_capacity];
+
+    bool is_inline(void) const { return (data == local); }
 
    public:
-    Vector(void) : data(nullptr), len(0){};
+    Vector(void) : data(local), len(0), _capacity(vector_inline_capacity){};
     Vector(const size_t len);
     Vector(const Vector &vector);
+    Vector(Vector &&vector);
     ~Vector(void);
     size_t length(void) const { return len; }
+    size_t capacity(void) const { return _capacity; }
     Floating &operator[](const size_t index) const;
     Vector operator+(const Vector &vector) const;
     Vector operator-(const Vector &vector) const;
@@ -52,10 +64,13 @@ class Vector {
     Vector &operator*=(const Floating scalar);
     Vector &operator=(const Floating value);
     Vector &operator=(const Vector &to_copy);
+    Vector &operator=(Vector &&to_move);
     bool operator==(const Vector &vector) const;
     bool operator!=(const Vector &vector) const;
+    void reserve(const size_t capacity);
     void resize(const size_t length);
-    Vector &random(const Floating min, const Floating max);
+    Vector &random(const Floating min, const Floating max, const uint64_t seed = random_seed());
+    Vector &random_normal(const Floating mean, const Floating deviation, const uint64_t seed = random_seed());
     std::string to_string(void) const;
     Vector cross_product(const Vector &vector) const;
     Floating norm(void) const;
@@ -78,28 +93,43 @@ class Vector {
 };
 
 template <typename Floating>
-Vector<Floating>::Vector(const size_t length) : data(nullptr), len(length) {
-    if (len != 0) {
+Vector<Floating>::Vector(const size_t length) : data(local), len(length), _capacity(vector_inline_capacity) {
+    if (len > vector_inline_capacity) {
         data = new Floating[len];
+        _capacity = len;
+    }
+}
+
+template <typename Floating>
+Vector<Floating>::Vector(const Vector<Floating> &vector) : Vector(vector.len) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = vector.data[i];
     }
 }
 
+// Takes over the heap buffer of vector, which is left empty. Inline
+// elements have to be copied
 template <typename Floating>
-Vector<Floating>::Vector(const Vector<Floating> &vector) : data(nullptr), len(vector.len) {
-    if (len != 0) {
-        data = new Floating[vector.len];
+Vector<Floating>::Vector(Vector<Floating> &&vector) : data(local), len(vector.len), _capacity(vector_inline_capacity) {
+    if (vector.is_inline()) {
         for (size_t i = 0; i < len; i++) {
             data[i] = vector.data[i];
         }
+    } else {
+        data = vector.data;
+        _capacity = vector._capacity;
+        vector.data = vector.local;
+        vector._capacity = vector_inline_capacity;
     }
+    vector.len = 0;
 }
 
 template <typename Floating>
 Vector<Floating>::~Vector(void) {
-    if (data != nullptr) {
+    if (!is_inline()) {
         delete[] data;
-        data = nullptr;
     }
+    data = local;
     len = 0;
 }
 
@@ -117,9 +147,14 @@ Vector<Floating> Vector<Floating>::operator+(const Vector<Floating> &vector) con
         throw std::runtime_error("Sum involving vectors with incompatible lengths!");
     }
     Vector<Floating> result(len);
-    for (size_t i = 0; i < len; i++) {
-        result.data[i] = data[i] + vector.data[i];
-    }
+    const Floating *a = data;
+    const Floating *b = vector.data;
+    Floating *r = result.data;
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            r[i] = a[i] + b[i];
+        }
+    });
     return result;
 }
 
@@ -129,18 +164,27 @@ Vector<Floating> Vector<Floating>::operator-(const Vector<Floating> &vector) con
         throw std::runtime_error("Subtraction involving vectors with incompatible lengths!");
     }
     Vector<Floating> result(len);
-    for (size_t i = 0; i < len; i++) {
-        result.data[i] = data[i] - vector.data[i];
-    }
+    const Floating *a = data;
+    const Floating *b = vector.data;
+    Floating *r = result.data;
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            r[i] = a[i] - b[i];
+        }
+    });
     return result;
 }
 
 template <typename Floating>
 Vector<Floating> Vector<Floating>::operator*(const Floating scalar) const {
     Vector result(len);
-    for (size_t i = 0; i < len; i++) {
-        result.data[i] = data[i] * scalar;
-    }
+    const Floating *a = data;
+    Floating *r = result.data;
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            r[i] = a[i] * scalar;
+        }
+    });
     return result;
 }
 
@@ -155,26 +199,39 @@ Floating Vector<Floating>::operator*(const Vector<Floating> &vector) const {
     if (len != vector.len) {
         throw std::runtime_error("Dot product involving vectors with incompatible lengths!");
     }
-    Floating result = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        result += data[i] * vector.data[i];
-    }
-    return result;
+    const Floating *a = data;
+    const Floating *b = vector.data;
+    return parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating sum = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        },
+        [](const Floating x, const Floating y) { return x + y; });
 }
 
 template <typename Floating>
 Vector<Floating> &Vector<Floating>::operator*=(const Floating scalar) {
-    for (size_t i = 0; i < len; i++) {
-        data[i] *= scalar;
-    }
+    Floating *r = data;
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            r[i] *= scalar;
+        }
+    });
     return *this;
 }
 
 template <typename Floating>
 Vector<Floating> &Vector<Floating>::operator=(const Floating value) {
-    for (size_t i = 0; i < len; i++) {
-        data[i] = value;
-    }
+    Floating *r = data;
+    parallel_for(len, [=](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            r[i] = value;
+        }
+    });
     return *this;
 }
 
@@ -189,17 +246,43 @@ Vector<Floating> &Vector<Floating>::operator=(const Vector<Floating> &to_copy) {
     return *this;
 }
 
+template <typename Floating>
+Vector<Floating> &Vector<Floating>::operator=(Vector<Floating> &&to_move) {
+    if (this == &to_move) {
+        return *this;
+    } else if (to_move.is_inline()) {
+        return (*this = static_cast<const Vector<Floating> &>(to_move));
+    }
+    if (!is_inline()) {
+        delete[] data;
+    }
+    data = to_move.data;
+    len = to_move.len;
+    _capacity = to_move._capacity;
+    to_move.data = to_move.local;
+    to_move.len = 0;
+    to_move._capacity = vector_inline_capacity;
+    return *this;
+}
+
 template <typename Floating>
 bool Vector<Floating>::operator==(const Vector &vector) const {
     if (len != vector.len) {
         return false;
     }
-    for (size_t i = 0; i < len; i++) {
-        if (!are_close<Floating>(data[i], vector.data[i], static_cast<Floating>(vector_precision))) {
-            return false;
-        }
-    }
-    return true;
+    const Floating *a = data;
+    const Floating *b = vector.data;
+    return parallel_reduce<bool>(
+        len, true,
+        [=](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (!are_close<Floating>(a[i], b[i], static_cast<Floating>(vector_precision))) {
+                    return false;
+                }
+            }
+            return true;
+        },
+        [](const bool x, const bool y) { return x && y; });
 }
 
 template <typename Floating>
@@ -207,25 +290,43 @@ bool Vector<Floating>::operator!=(const Vector &vector) const {
     return !(this->operator==(vector));
 }
 
+// Makes room for at least capacity elements, keeping the current ones
 template <typename Floating>
-void Vector<Floating>::resize(const size_t length) {
-    if (data != nullptr) {
-        delete[] data;
-        data = nullptr;
+void Vector<Floating>::reserve(const size_t capacity) {
+    if (capacity <= _capacity) {
+        return;
     }
-    len = 0;
-    if (length != 0) {
-        data = new Floating[length];
-        len = length;
+    Floating *new_data = new Floating[capacity];
+    for (size_t i = 0; i < len; i++) {
+        new_data[i] = data[i];
+    }
+    if (!is_inline()) {
+        delete[] data;
     }
+    data = new_data;
+    _capacity = capacity;
 }
 
+// Keeps the first elements, and only allocates memory when the length
+// exceeds the capacity, which then grows geometrically. The new elements
+// are left uninitialized
 template <typename Floating>
-Vector<Floating> &Vector<Floating>::random(const Floating min, const Floating max) {
-    srand(static_cast<unsigned int>(time(NULL)));
-    for (size_t i = 0; i < len; i++) {
-        data[i] = random_number<Floating>(min, max);
+void Vector<Floating>::resize(const size_t length) {
+    if (length > _capacity) {
+        reserve(maximum<size_t>(length, 2 * _capacity));
     }
+    len = length;
+}
+
+template <typename Floating>
+Vector<Floating> &Vector<Floating>::random(const Floating min, const Floating max, const uint64_t seed) {
+    fill_uniform(data, len, min, max, seed);
+    return *this;
+}
+
+template <typename Floating>
+Vector<Floating> &Vector<Floating>::random_normal(const Floating mean, const Floating deviation, const uint64_t seed) {
+    fill_normal(data, len, mean, deviation, seed);
     return *this;
 }
 
@@ -257,46 +358,78 @@ Vector<Floating> Vector<Floating>::cross_product(const Vector<Floating> &vector)
 
 template <typename Floating>
 Floating Vector<Floating>::norm(void) const {
-    Floating value = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        value += data[i] * data[i];
-    }
+    const Floating *a = data;
+    const Floating value = parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating sum = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                sum += a[i] * a[i];
+            }
+            return sum;
+        },
+        [](const Floating x, const Floating y) { return x + y; });
     return square_root<Floating>(value);
 }
 
 template <typename Floating>
 Floating Vector<Floating>::max(void) const {
-    Floating value = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        value = maximum<Floating>(value, data[i]);
-    }
-    return value;
+    const Floating *a = data;
+    return parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating value = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                value = maximum<Floating>(value, a[i]);
+            }
+            return value;
+        },
+        maximum<Floating>);
 }
 
 template <typename Floating>
 Floating Vector<Floating>::min(void) const {
-    Floating value = static_cast<Floating>(INFINITY);
-    for (size_t i = 0; i < len; i++) {
-        value = minimum(value, data[i]);
-    }
-    return value;
+    const Floating *a = data;
+    return parallel_reduce<Floating>(
+        len, static_cast<Floating>(INFINITY),
+        [=](const size_t begin, const size_t end) {
+            Floating value = static_cast<Floating>(INFINITY);
+            for (size_t i = begin; i < end; i++) {
+                value = minimum(value, a[i]);
+            }
+            return value;
+        },
+        minimum<Floating>);
 }
 
 template <typename Floating>
 Floating Vector<Floating>::max_abs(void) const {
-    Floating error = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        error = maximum(fabs(data[i]), error);
-    }
-    return error;
+    const Floating *a = data;
+    return parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating error = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                error = maximum(std::fabs(a[i]), error);
+            }
+            return error;
+        },
+        maximum<Floating>);
 }
 
 template <typename Floating>
 Floating Vector<Floating>::mean(void) const {
-    Floating sum = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        sum += data[i];
-    }
+    const Floating *a = data;
+    const Floating sum = parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating value = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                value += a[i];
+            }
+            return value;
+        },
+        [](const Floating x, const Floating y) { return x + y; });
     return (sum / static_cast<Floating>(len));
 }
 
@@ -305,11 +438,18 @@ Floating Vector<Floating>::max_diff(const Vector &vector) const {
     if (len != vector.len) {
         throw std::runtime_error("Comparisson involving vectors with incompatible lengths!");
     }
-    Floating error = static_cast<Floating>(0.0);
-    for (size_t i = 0; i < len; i++) {
-        error = maximum<Floating>(fabs(data[i] - vector.data[i]), error);
-    }
-    return error;
+    const Floating *a = data;
+    const Floating *b = vector.data;
+    return parallel_reduce<Floating>(
+        len, static_cast<Floating>(0.0),
+        [=](const size_t begin, const size_t end) {
+            Floating error = static_cast<Floating>(0.0);
+            for (size_t i = begin; i < end; i++) {
+                error = maximum<Floating>(std::fabs(a[i] - b[i]), error);
+            }
+            return error;
+        },
+        maximum<Floating>);
 }
 
 template <typename Floating>
@@ -330,40 +470,10 @@ bool Vector<Floating>::is_sorted(void) const {
     return true;
 }
 
-template <typename Floating>
-void qs(const Floating *array, const size_t left, const size_t right) {
-    const Floating middle = array[(left + right) / 2];
-    size_t i = left;
-    size_t j = right;
-    do {
-        while (array[i] < middle && i < right) {
-            i++;
-        }
-        while (middle < array[j] && j > left && j != 0) {
-            j--;
-        }
-        if (i <= j) {
-            swap<Floating>(array[i], array[j]);
-            i++;
-            if (j != 0) {
-                j--;
-            }
-        }
-    } while (i <= j);
-    if (left < j) {
-        qs<Floating>(array, left, j);
-    }
-    if (i < right) {
-        qs<Floating>(array, i, right);
-    }
-}
-
-// Quicksort algorithm
+// Introsort, which is parallelized for long vectors
 template <typename Floating>
 void Vector<Floating>::sort(void) {
-    if (len != 0) {
-        qs<Floating>(data, 0, len - 1);
-    }
+    parallel_sort<Floating>(data, len);
 }
 
 template <typename Floating>
@@ -381,13 +491,14 @@ size_t Vector<Floating>::search(const double value) const {
 
 template <typename Floating>
 size_t Vector<Floating>::binary_search(const double value) const {
+    // Searches the half-open range [low, high), so high never underflows
     size_t middle = len;
     size_t low = 0;
-    size_t high = len - 1;
-    while (low <= high) {
-        middle = (low + high) / 2;
+    size_t high = len;
+    while (low < high) {
+        middle = low + (high - low) / 2;
         if (value < data[middle]) {
-            high = middle - 1;
+            high = middle;
         } else if (value > data[middle]) {
             low = middle + 1;
         } else {
@@ -0,0 +1,89 @@
+#include "../lib/complex-matrix.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#define DEFAULT_SIZE 128
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Largest difference between the parts, relative to the largest part of the reference
+double relative_error(const Complex_Matrix<double> &result, const Matrix<Complex<double>> &expected) {
+    double error = 0.0;
+    double scale = 0.0;
+    for (size_t i = 0; i < expected.rows(); i++) {
+        for (size_t j = 0; j < expected.cols(); j++) {
+            const Complex<double> value = result(i, j);
+            error = maximum(error, std::fabs(value.real_part() - expected(i, j).real_part()));
+            error = maximum(error, std::fabs(value.imag_part() - expected(i, j).imag_part()));
+            scale = maximum(scale, std::fabs(expected(i, j).real_part()));
+            scale = maximum(scale, std::fabs(expected(i, j).imag_part()));
+        }
+    }
+    return error / maximum(scale, 1.0);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t size = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_SIZE;
+    {
+        Matrix<Complex<double>> X(2, 3);
+        X(0, 0) = Complex<double>(1.0, 2.0);
+        X(0, 1) = Complex<double>(0.0, -1.0);
+        X(0, 2) = Complex<double>(3.0);
+        X(1, 0) = Complex<double>(-2.0, 1.0);
+        X(1, 1) = Complex<double>(4.0, 4.0);
+        X(1, 2) = Complex<double>(0.5, -0.5);
+        const Complex_Matrix<double> A(X);
+        const Complex_Matrix<double> B(X.transpose());
+        const Matrix<Complex<double>> expected = X * X.transpose();
+        if (!(A.to_matrix() == X) || !(A.multiply_4m(B).to_matrix() == expected) || !((A * B).to_matrix() == expected)) {
+            std::cerr << "The small complex product was NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+        bool thrown = false;
+        try {
+            const Complex_Matrix<double> product = A * A;
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        if (!thrown) {
+            std::cerr << "Matrices with incompatible sizes were multiplied!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    Matrix<double> ar(size, size), ai(size, size), br(size, size), bi(size, size);
+    ar.random(-1.0, 1.0, 1);
+    ai.random(-1.0, 1.0, 2);
+    br.random(-1.0, 1.0, 3);
+    bi.random(-1.0, 1.0, 4);
+    const Complex_Matrix<double> A(ar, ai);
+    const Complex_Matrix<double> B(br, bi);
+    const Matrix<Complex<double>> X = A.to_matrix();
+    const Matrix<Complex<double>> Y = B.to_matrix();
+    auto start = std::chrono::steady_clock::now();
+    const Matrix<Complex<double>> expected = X * Y;
+    const double interleaved_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    const Complex_Matrix<double> four = A.multiply_4m(B);
+    const double four_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    const Complex_Matrix<double> three = A.multiply_3m(B);
+    const double three_ns = elapsed_ns(start);
+    const double four_error = relative_error(four, expected);
+    const double three_error = relative_error(three, expected);
+    if ((four_error > 1e-13) || (three_error > 1e-13)) {
+        std::cerr << "The complex products differ from the reference: 4M " << four_error << ", 3M " << three_error << std::endl;
+        return EXIT_FAILURE;
+    }
+    // A complex multiply-add is 8 real floating-point operations
+    const double flops = 8.0 * static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(size);
+    std::cout << "Complex product of " << size << "x" << size << " matrices:\n";
+    std::cout << "Matrix<Complex<double>>: " << flops / interleaved_ns << " GFLOP/s\n";
+    std::cout << "4M split planes:         " << flops / four_ns << " GFLOP/s (relative error " << four_error << ")\n";
+    std::cout << "3M split planes:         " << flops / three_ns << " GFLOP/s (relative error " << three_error << ")\n";
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "../lib/complex-vector.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define DEFAULT_LENGTH (1 << 20)
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<Complex<double>> make_values(const size_t length, const uint64_t seed) {
+    Random random(seed);
+    std::vector<Complex<double>> values(length);
+    for (auto &value : values) {
+        value = Complex<double>(random.uniform(-10.0, 10.0), random.uniform(-10.0, 10.0));
+    }
+    return values;
+}
+
+// Errors are relative to the modulus, since a product like a*d + b*c may
+// cancel, and FMA contraction changes its rounding
+bool same(const Complex<double> a, const Complex<double> b) {
+    const double scale = 1e-15 * maximum(std::fabs(b.real_part()), std::fabs(b.imag_part()));
+    return (std::fabs(a.real_part() - b.real_part()) <= scale) && (std::fabs(a.imag_part() - b.imag_part()) <= scale);
+}
+
+bool check_operations(const size_t length) {
+    const std::vector<Complex<double>> a = make_values(length, 1);
+    const std::vector<Complex<double>> b = make_values(length, 2);
+    const Complex_Vector<double> va(a);
+    const Complex_Vector<double> vb(b);
+    const Complex_Vector<double> sum = va + vb;
+    const Complex_Vector<double> difference = va - vb;
+    const Complex_Vector<double> product = va * vb;
+    const Complex_Vector<double> quotient = va / vb;
+    const Complex_Vector<double> correlation = va.conjugate_multiply(vb);
+    const Vector<double> modulus = va.modulus();
+    const Vector<double> argument = va.argument();
+    const std::vector<Complex<double>> round_trip = va.to_complex();
+    Complex_Vector<double> in_place = va;
+    in_place /= vb;
+    for (size_t i = 0; i < length; i++) {
+        if (!same(sum[i], a[i] + b[i]) || !same(in_place[i], a[i] / b[i]) || !same(difference[i], a[i] - b[i]) || !same(product[i], a[i] * b[i]) || !same(quotient[i], a[i] / b[i]) ||
+            !same(correlation[i], a[i] * b[i].conjugate()) || !same(round_trip[i], a[i])) {
+            std::cerr << "The complex vectors of length " << length << " differ at position " << i << "!\n";
+            return false;
+        }
+        const double expected_modulus = std::sqrt(a[i].real_part() * a[i].real_part() + a[i].imag_part() * a[i].imag_part());
+        const double expected_argument = std::atan2(a[i].imag_part(), a[i].real_part());
+        if ((std::fabs(modulus[i] - expected_modulus) > 1e-15 * expected_modulus) || (std::fabs(argument[i] - expected_argument) > 4e-16 * std::fabs(expected_argument))) {
+            std::cerr << "The modulus or the argument of " << a[i] << " was NOT properly calculated: " << modulus[i] << ", " << argument[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_special_arguments(void) {
+    const double values[][2] = {{0.0, 1.0}, {0.0, -1.0}, {1.0, 0.0}, {-1.0, 0.0}, {1.0, 1.0}, {-1.0, -1.0}, {0.0, 0.0}, {1e-300, -1e300}, {-0.0, 2.0}};
+    std::vector<Complex<double>> complex;
+    for (auto value : values) {
+        complex.push_back(Complex<double>(value[1], value[0]));
+    }
+    const Vector<double> argument = Complex_Vector<double>(complex).argument();
+    for (size_t i = 0; i < complex.size(); i++) {
+        const double expected = std::atan2(values[i][0], values[i][1]);
+        std::cout << "atan2(" << values[i][0] << ", " << values[i][1] << ") = " << argument[i] << " (expected " << expected << ")" << std::endl;
+        if (std::fabs(argument[i] - expected) > 4e-16 * std::fabs(expected)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    const size_t lengths[] = {0, 1, 3, 7, 8, 9, 31, 100, 1000};
+    for (auto l : lengths) {
+        if (!check_operations(l)) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (!check_special_arguments()) {
+        std::cerr << "The argument was NOT properly calculated for special values!\n";
+        return EXIT_FAILURE;
+    }
+    const std::vector<Complex<double>> a = make_values(length, 3);
+    const std::vector<Complex<double>> b = make_values(length, 4);
+    std::vector<Complex<double>> interleaved(length);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < length; i++) {
+        interleaved[i] = a[i] * b[i];
+    }
+    const double interleaved_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        checksum += a[i].argument();
+    }
+    const double scalar_argument_ns = elapsed_ns(start);
+    const Complex_Vector<double> va(a);
+    const Complex_Vector<double> vb(b);
+    start = std::chrono::steady_clock::now();
+    const Complex_Vector<double> product = va * vb;
+    const double split_ns = elapsed_ns(start);
+    Complex_Vector<double> in_place(va);
+    start = std::chrono::steady_clock::now();
+    in_place *= vb;
+    const double in_place_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    const Complex_Vector<double> quotient = va / vb;
+    const double divide_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    const Vector<double> argument = va.argument();
+    const double argument_ns = elapsed_ns(start);
+    checksum += product[length / 2].real_part() + in_place[length / 2].real_part() + quotient[length / 2].real_part() + argument[length / 2];
+    std::cout << "\n" << length << " complex numbers (checksum " << checksum << ", " << Simd<double>::width << " doubles per register)" << std::endl;
+    std::cout << "Complex<double> multiply:     " << interleaved_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    std::cout << "Complex_Vector multiply:      " << split_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    std::cout << "Complex_Vector multiply (*=): " << in_place_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    std::cout << "Complex_Vector divide:        " << divide_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    std::cout << "Complex<double>::argument:    " << scalar_argument_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    std::cout << "Complex_Vector::argument:     " << argument_ns / static_cast<double>(length) << " ns per element" << std::endl;
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
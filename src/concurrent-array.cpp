@@ -0,0 +1,161 @@
+#include "../lib/concurrent-array.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../lib/dynamic-array.hpp"
+
+#define DEFAULT_PUSHES (1 << 20)
+#define MAXIMUM_THREADS 64
+
+std::string make_string(const size_t thread, const size_t index) {
+    return "thread " + std::to_string(thread) + " value " + std::to_string(index);
+}
+
+// Writers push strings while a reader walks the published prefix, which
+// must only hold completely built strings
+bool check_concurrent_pushes(void) {
+    const size_t writers = 8;
+    const size_t pushes = 20000;
+    Concurrent_Array<std::string, 64> array;
+    std::atomic<bool> writing(true);
+    std::atomic<bool> reader_failed(false);
+    std::thread reader([&] {
+        size_t previous = 0;
+        while (writing.load()) {
+            size_t count = 0;
+            for (const std::string &value : array) {
+                if (value.compare(0, 7, "thread ") != 0) {
+                    reader_failed = true;
+                }
+                count++;
+            }
+            if (count < previous) {
+                reader_failed = true;
+            }
+            previous = count;
+        }
+    });
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < writers; t++) {
+        threads.emplace_back([&array, t] {
+            for (size_t i = 0; i < pushes; i++) {
+                array.push(make_string(t, i));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    writing = false;
+    reader.join();
+    if (reader_failed) {
+        std::cerr << "The reader saw an element which was not completely built!\n";
+        return false;
+    }
+    if (array.length() != writers * pushes) {
+        std::cerr << "The concurrent array has " << array.length() << " elements instead of " << writers * pushes << "!\n";
+        return false;
+    }
+    // The values of each thread are in the order they were pushed
+    std::vector<size_t> next(writers, 0);
+    for (const std::string &value : array) {
+        const size_t thread = std::stoul(value.substr(7));
+        if ((thread >= writers) || (value != make_string(thread, next[thread]))) {
+            std::cerr << "The concurrent array has the unexpected value \"" << value << "\"!\n";
+            return false;
+        }
+        next[thread]++;
+    }
+    // Each element holds a reference, which the array must release
+    const std::shared_ptr<int> shared = std::make_shared<int>(7);
+    {
+        Concurrent_Array<std::shared_ptr<int>, 16> references;
+        for (int i = 0; i < 1000; i++) {
+            references.push(shared);
+        }
+        if ((references.capacity() != 1008) || (shared.use_count() != 1001)) {
+            std::cerr << "The concurrent array of shared pointers was NOT properly built!\n";
+            return false;
+        }
+    }
+    if (shared.use_count() != 1) {
+        std::cerr << shared.use_count() - 1 << " elements were NOT destroyed by the concurrent array!\n";
+        return false;
+    }
+    std::cout << writers << " threads pushed " << writers * pushes << " strings while another one read them\n\n";
+    return true;
+}
+
+// Dynamic_Array behind a mutex, the alternative to the concurrent array
+template <typename Number>
+class Locked_Array {
+   private:
+    std::mutex mutex;
+    Dynamic_Array<Number> array;
+
+   public:
+    void push(const Number &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        array.push(value);
+    }
+    size_t length(void) const { return array.length(); }
+};
+
+// Million pushes per second, with the pushes split between the threads
+template <typename Array>
+double pushes_per_second(const size_t threads, const size_t pushes) {
+    Array array;
+    std::vector<std::thread> workers;
+    const size_t each = pushes / threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&array, each, t] {
+            for (size_t i = 0; i < each; i++) {
+                array.push(static_cast<long>(t * each + i));
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(array.length()) / elapsed.count() / 1e6;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t pushes = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_PUSHES;
+    Concurrent_Array<int, 4> array;
+    for (int i = 0; i < 16; i++) {
+        array.push(i);
+    }
+    std::cout << "Array after insertion:\n"
+              << array << std::endl;
+    std::cout << "Value at index 5: " << array.value_at(5) << std::endl;
+    std::cout << "Find value 10 at position " << array.find(10) << std::endl;
+    std::cout << "For each loop in the array:\n";
+    for (auto &value : array) {
+        std::cout << value << ", ";
+    }
+    std::cout << std::endl
+              << std::endl;
+    if (!check_concurrent_pushes()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "Pushing " << pushes << " long integers, in million pushes per second ("
+              << std::thread::hardware_concurrency() << " hardware threads):\n"
+              << "threads  Concurrent_Array  Dynamic_Array with mutex\n";
+    for (size_t threads = 1; threads <= MAXIMUM_THREADS; threads *= 2) {
+        const double concurrent = pushes_per_second<Concurrent_Array<long>>(threads, pushes);
+        const double locked = pushes_per_second<Locked_Array<long>>(threads, pushes);
+        std::cout << std::setw(7) << threads << std::setw(18) << concurrent << std::setw(26) << locked << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "../lib/convolution.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#define DEFAULT_LENGTH (1 << 16)
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+Vector<double> make_vector(const size_t length, const uint64_t seed) {
+    Vector<double> vector(length);
+    vector.random(-1.0, 1.0, seed);
+    return vector;
+}
+
+double max_error(const Vector<double> &a, const Vector<double> &b) {
+    if (a.length() != b.length()) {
+        return INFINITY;
+    }
+    double error = 0.0;
+    for (size_t i = 0; i < a.length(); i++) {
+        error = maximum(error, std::fabs(a[i] - b[i]));
+    }
+    return error;
+}
+
+bool check_convolution(const size_t signal_length, const size_t kernel_length) {
+    const Vector<double> signal = make_vector(signal_length, 2 * signal_length);
+    const Vector<double> kernel = make_vector(kernel_length, 2 * kernel_length + 1);
+    const Vector<double> expected = direct_convolution(signal, kernel);
+    const double fft_error = max_error(fft_convolution(signal, kernel), expected);
+    const double automatic_error = max_error(convolve(kernel, signal), expected);
+    // Streams fed in chunks of varying sizes must give the same outputs
+    Stream_Convolution<double> stream(kernel);
+    Vector<double> streamed(signal_length);
+    for (size_t done = 0, chunk = 1; done < signal_length; done += chunk, chunk = 2 * chunk + 1) {
+        chunk = minimum(chunk, signal_length - done);
+        stream.process(signal.begin() + done, streamed.begin() + done, chunk);
+    }
+    double stream_error = 0.0;
+    for (size_t i = 0; i < signal_length; i++) {
+        stream_error = maximum(stream_error, std::fabs(streamed[i] - expected[i]));
+    }
+    const double tolerance = 1e-12 * static_cast<double>(kernel_length);
+    if ((fft_error > tolerance) || (automatic_error > tolerance) || (stream_error > tolerance)) {
+        std::cerr << "Convolution of " << signal_length << " samples with " << kernel_length << " taps failed: errors " << fft_error << ", "
+                  << automatic_error << ", " << stream_error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool check_correlation(void) {
+    // The correlation of a signal with a delayed copy peaks at the delay
+    const size_t length = 1000;
+    const size_t delay = 123;
+    const Vector<double> signal = make_vector(length, 5);
+    Vector<double> delayed(length);
+    delayed = 0.0;
+    for (size_t i = delay; i < length; i++) {
+        delayed[i] = signal[i - delay];
+    }
+    const Vector<double> correlation = correlate(delayed, signal);
+    size_t peak = 0;
+    for (size_t i = 0; i < correlation.length(); i++) {
+        if (correlation[i] > correlation[peak]) {
+            peak = i;
+        }
+    }
+    std::cout << "Correlation peak at lag " << static_cast<double>(peak) - static_cast<double>(length - 1) << " (expected " << delay << ")" << std::endl;
+    return peak == (length - 1) + delay;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    const size_t cases[][2] = {{1, 1}, {10, 1}, {1, 10}, {100, 7}, {1000, 49}, {1000, 100}, {5000, 333}, {777, 777}, {4096, 1024}};
+    for (auto c : cases) {
+        if (!check_convolution(c[0], c[1])) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (!check_correlation()) {
+        std::cerr << "The correlation was NOT properly calculated!\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "\nConvolution of " << length << " samples (ns per output):\n";
+    std::cout << std::left << std::setw(8) << "taps" << std::setw(12) << "direct" << std::setw(12) << "fft" << std::endl;
+    const Vector<double> signal = make_vector(length, 1);
+    for (size_t taps = 8; taps <= 1024; taps *= 2) {
+        const Vector<double> kernel = make_vector(taps, taps);
+        auto start = std::chrono::steady_clock::now();
+        const Vector<double> direct = direct_convolution(signal, kernel);
+        const double direct_ns = elapsed_ns(start);
+        start = std::chrono::steady_clock::now();
+        const Vector<double> fft = fft_convolution(signal, kernel);
+        const double fft_ns = elapsed_ns(start);
+        const double outputs = static_cast<double>(direct.length());
+        std::cout << std::setw(8) << taps << std::setw(12) << direct_ns / outputs << std::setw(12) << fft_ns / outputs << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
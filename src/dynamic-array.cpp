@@ -1,9 +1,326 @@
 #include "../lib/dynamic-array.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
-int main(void) {
+#define DEFAULT_PUSHES (1 << 20)
+#define DEFAULT_QUEUE_LENGTH (1 << 14)
+
+// Counts the copies, moves and live objects, to check that growth moves the
+// elements and that every element is destroyed
+struct Tracked {
+    static long copies;
+    static long moves;
+    static long live;
+    int value;
+
+    Tracked(const int value) : value(value) { live++; }
+    Tracked(const Tracked &other) : value(other.value) {
+        copies++;
+        live++;
+    }
+    Tracked(Tracked &&other) noexcept : value(other.value) {
+        moves++;
+        live++;
+    }
+    ~Tracked(void) { live--; }
+    Tracked &operator=(const Tracked &other) {
+        copies++;
+        value = other.value;
+        return *this;
+    }
+    Tracked &operator=(Tracked &&other) noexcept {
+        moves++;
+        value = other.value;
+        return *this;
+    }
+    bool operator==(const Tracked &other) const { return value == other.value; }
+};
+
+long Tracked::copies = 0;
+long Tracked::moves = 0;
+long Tracked::live = 0;
+
+// The growth of the previous implementation, which default-constructs the
+// whole new buffer and copy-assigns every element, for comparison
+template <typename Number>
+class Copying_Array {
+   private:
+    Number *values;
+    size_t capacity;
+    size_t length;
+
+   public:
+    Copying_Array(void) : values(new Number[initial_array_capacity]), capacity(initial_array_capacity), length(0) {}
+    ~Copying_Array(void) { delete[] values; }
+    void push(const Number value) {
+        if (length + 1 > capacity) {
+            capacity *= 2;
+            Number *new_values = new Number[capacity];
+            std::copy(&values[0], &values[length], new_values);
+            delete[] values;
+            values = new_values;
+        }
+        values[length] = value;
+        length++;
+    }
+};
+
+// std::vector under the same interface
+template <typename Number>
+struct Standard_Array : std::vector<Number> {
+    void push(const Number &value) { this->push_back(value); }
+};
+
+bool check_elements(void) {
+    {
+        Dynamic_Array<std::string> strings;
+        for (int i = 0; i < 100; i++) {
+            strings.push("string number " + std::to_string(i));
+        }
+        strings.emplace_back(3, 'x');
+        // Aliasing an element while the array grows
+        strings.shrink_to_fit();
+        strings.push(strings[0]);
+        Dynamic_Array<std::string> copy(strings);
+        Dynamic_Array<std::string> moved(std::move(copy));
+        copy = moved;
+        if ((strings.length() != 102) || (strings[100] != "xxx") || (strings[101] != "string number 0") || (moved.length() != 102) || (copy[50] != "string number 50")) {
+            std::cerr << "The array of strings was NOT properly built!\n";
+            return false;
+        }
+        strings.unshift("first");
+        strings.delete_at(1);
+        if ((strings.shift() != "first") || (strings.pop() != "string number 0") || (strings[0] != "string number 1") || (strings.length() != 100)) {
+            std::cerr << "The array of strings was NOT properly edited!\n";
+            return false;
+        }
+        strings.reserve(1000);
+        const size_t reserved = strings.capacity();
+        strings.shrink_to_fit();
+        if ((reserved != 1000) || (strings.capacity() != strings.length()) || (strings[99] != "xxx")) {
+            std::cerr << "The capacity of the array of strings was NOT properly changed!\n";
+            return false;
+        }
+    }
+    {
+        Dynamic_Array<Tracked> tracked;
+        for (int i = 0; i < 1000; i++) {
+            tracked.emplace_back(i);
+        }
+        tracked.pop();
+        tracked.shift();
+        if ((Tracked::copies != 0) || (Tracked::live != 998) || (tracked[0].value != 1)) {
+            std::cerr << "The array made " << Tracked::copies << " copies and holds " << Tracked::live << " objects!\n";
+            return false;
+        }
+    }
+    if (Tracked::live != 0) {
+        std::cerr << Tracked::live << " objects were NOT destroyed by the array!\n";
+        return false;
+    }
+    std::cout << "Growing the array moved " << Tracked::moves << " elements, and made no copies\n\n";
+    return true;
+}
+
+template <typename Array, typename Number>
+double pushes_per_second(const std::vector<Number> &inputs) {
+    const auto start = std::chrono::steady_clock::now();
+    {
+        Array array;
+        for (const Number &value : inputs) {
+            array.push(value);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(inputs.size()) / elapsed.count();
+}
+
+// Best of a few rounds, each running all the arrays in turn, since the
+// state of the heap left by one array changes the speed of the next
+template <typename Number>
+void benchmark_push(const std::vector<Number> &inputs, const char *name) {
+    double best[3] = {0.0, 0.0, 0.0};
+    for (int round = 0; round < 5; round++) {
+        best[0] = std::max(best[0], pushes_per_second<Dynamic_Array<Number>>(inputs));
+        best[1] = std::max(best[1], pushes_per_second<Copying_Array<Number>>(inputs));
+        best[2] = std::max(best[2], pushes_per_second<Standard_Array<Number>>(inputs));
+    }
+    std::cout << name << " with " << inputs.size() << " pushes, in millions per second:\n"
+              << "    Dynamic_Array: " << best[0] / 1e6 << "\n"
+              << "    copying growth: " << best[1] / 1e6 << "\n"
+              << "    std::vector: " << best[2] / 1e6 << "\n";
+}
+
+size_t minimum_size(const size_t a, const size_t b) {
+    return (a < b) ? a : b;
+}
+
+// Random pushes, pops, shifts, unshifts, insertions and deletions, against
+// std::vector. Insertions also take ranges from the array itself, which may
+// or may not have to grow
+template <typename Number>
+bool check_against_vector(const char *name, Number (*make)(int)) {
+    Dynamic_Array<Number> array;
+    std::vector<Number> expected;
+    uint64_t state = 12345;
+    for (int i = 0; i < 20000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const int operation = static_cast<int>((state >> 33) % 13);
+        if ((operation < 3) || expected.empty()) {
+            array.push(make(i));
+            expected.push_back(make(i));
+        } else if (operation < 5) {
+            array.unshift(make(i));
+            expected.insert(expected.begin(), make(i));
+        } else if (operation == 5) {
+            if (!(array.pop() == expected.back())) {
+                break;
+            }
+            expected.pop_back();
+        } else if (operation < 8) {
+            if (!(array.shift() == expected.front())) {
+                break;
+            }
+            expected.erase(expected.begin());
+        } else if (operation == 8) {
+            const size_t index = static_cast<size_t>(state >> 40) % expected.size();
+            array.delete_at(index);
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+        } else if (operation == 9) {
+            const size_t index = static_cast<size_t>(state >> 40) % (expected.size() + 1);
+            Number range[] = {make(i), make(i + 1), make(i + 2)};
+            array.insert(index, range, range + 3);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), range, range + 3);
+        } else if (operation == 10) {
+            const size_t first = static_cast<size_t>(state >> 40) % expected.size();
+            const size_t last = first + minimum_size(expected.size() - first, static_cast<size_t>(state >> 20) % 4);
+            array.erase(first, last);
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(first), expected.begin() + static_cast<std::ptrdiff_t>(last));
+        } else if (operation == 11) {
+            const size_t index = static_cast<size_t>(state >> 40) % expected.size();
+            array.swap_remove(index);
+            expected[index] = expected.back();
+            expected.pop_back();
+        } else if (expected.size() < 300) {
+            const size_t index = static_cast<size_t>(state >> 40) % (expected.size() + 1);
+            const size_t count = minimum_size(expected.size(), 5);
+            array.insert(index, array.begin(), array.begin() + count);
+            std::vector<Number> range(expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>(count));
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), range.data(), range.data() + count);
+        } else {
+            const Number removed = expected[static_cast<size_t>(state >> 40) % expected.size()];
+            const size_t previous_length = expected.size();
+            expected.erase(std::remove(expected.begin(), expected.end(), removed), expected.end());
+            if (array.erase_if([&removed](const Number &value) { return value == removed; }) != previous_length - expected.size()) {
+                break;
+            }
+        }
+        if ((i % 1000 == 999) && (array.make_contiguous() != array.begin())) {
+            break;
+        }
+        if (!std::equal(expected.begin(), expected.end(), array.begin()) || (array.length() != expected.size())) {
+            break;
+        }
+        if (i == 19999) {
+            return true;
+        }
+    }
+    std::cerr << "The array of " << name << " does NOT match std::vector!\n";
+    return false;
+}
+
+int make_int(const int value) { return value; }
+std::string make_string(const int value) { return "value number " + std::to_string(value); }
+Tracked make_tracked(const int value) { return Tracked(value); }
+
+// Removes every third element, one at a time with delete_at, which moves
+// the tail each time, and in a single pass with erase_if
+void benchmark_erase(const size_t length) {
+    Dynamic_Array<long> one_at_a_time, single_pass;
+    for (size_t i = 0; i < length; i++) {
+        one_at_a_time.push(static_cast<long>(i));
+        single_pass.push(static_cast<long>(i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = length - length % 3; i + 3 > 0; i -= 3) {
+        if (i < one_at_a_time.length()) {
+            one_at_a_time.delete_at(i);
+        }
+    }
+    const std::chrono::duration<double, std::milli> deleting = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    single_pass.erase_if([](const long value) { return value % 3 == 0; });
+    const std::chrono::duration<double, std::milli> erasing = std::chrono::steady_clock::now() - start;
+    if ((one_at_a_time.length() != single_pass.length()) || !std::equal(single_pass.begin(), single_pass.end(), one_at_a_time.begin())) {
+        std::cerr << "The benchmarks of erase_if and delete_at do NOT match!\n";
+    }
+    std::cout << "Removing every third of " << length << " elements:\n"
+              << "    delete_at: " << deleting.count() << " ms\n"
+              << "    erase_if: " << erasing.count() << " ms\n";
+}
+
+// The previous shift and unshift, which move every element, through
+// std::vector under the same interface
+template <typename Number>
+struct Shifting_Array : std::vector<Number> {
+    void push(const Number &value) { this->push_back(value); }
+    void unshift(const Number &value) { this->insert(this->begin(), value); }
+    Number shift(void) {
+        const Number value = this->front();
+        this->erase(this->begin());
+        return value;
+    }
+};
+
+// A work queue holding length entries: fill it, then take one from the
+// front and put one at the back for every entry, and drain it. Then a
+// stack at the front, with unshift and shift
+template <typename Array>
+double queue_operations_per_second(const size_t length) {
+    const auto start = std::chrono::steady_clock::now();
+    long checksum = 0;
+    {
+        Array array;
+        for (size_t i = 0; i < length; i++) {
+            array.push(static_cast<long>(i));
+        }
+        for (size_t i = 0; i < length; i++) {
+            checksum += array.shift();
+            array.push(static_cast<long>(i));
+        }
+        for (size_t i = 0; i < length; i++) {
+            checksum += array.shift();
+        }
+        for (size_t i = 0; i < length; i++) {
+            array.unshift(static_cast<long>(i));
+        }
+        for (size_t i = 0; i < length; i++) {
+            checksum -= array.shift();
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum != static_cast<long>(length * (length - 1) / 2)) {
+        std::cerr << "Wrong checksum!\n";
+    }
+    return static_cast<double>(6 * length) / elapsed.count();
+}
+
+void benchmark_queue(const size_t length) {
+    std::cout << "Work queue of " << length << " entries, in millions of operations per second:\n"
+              << "    Dynamic_Array: " << queue_operations_per_second<Dynamic_Array<long>>(length) / 1e6 << "\n"
+              << "    moving every element: " << queue_operations_per_second<Shifting_Array<long>>(length) / 1e6 << "\n";
+    std::cout << "Work queue of " << 64 * length << " entries, in millions of operations per second:\n"
+              << "    Dynamic_Array: " << queue_operations_per_second<Dynamic_Array<long>>(64 * length) / 1e6 << "\n";
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t pushes = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_PUSHES;
+    const size_t queue_length = (argc >= 3) ? strtoul(argv[2], nullptr, 10) : DEFAULT_QUEUE_LENGTH;
     Dynamic_Array<int> array;
     std::cout << "Array before insertion:\n"
               << array << std::endl;
@@ -32,6 +349,26 @@ int main(void) {
     for (auto value : array) {
         std::cout << value << ", ";
     }
-    std::cout << std::endl;
+    std::cout << std::endl
+              << std::endl;
+    if (!check_elements() || !check_against_vector("int", make_int) || !check_against_vector("std::string", make_string) || !check_against_vector("Tracked", make_tracked)) {
+        return EXIT_FAILURE;
+    }
+    if (Tracked::live != 0) {
+        std::cerr << Tracked::live << " objects were NOT destroyed by the array!\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<int> integers(pushes);
+    std::vector<std::string> strings(pushes / 4);
+    for (size_t i = 0; i < integers.size(); i++) {
+        integers[i] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < strings.size(); i++) {
+        strings[i] = "a string long enough to be on the heap " + std::to_string(i);
+    }
+    benchmark_push(integers, "int");
+    benchmark_push(strings, "std::string");
+    benchmark_queue(queue_length);
+    benchmark_erase(4 * queue_length);
     return EXIT_SUCCESS;
 }
\ No newline at end of file
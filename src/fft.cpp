@@ -0,0 +1,202 @@
+#include "../lib/fft.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#define DEFAULT_MAX_BITS 16
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<Complex<double>> make_signal(const size_t length) {
+    std::vector<Complex<double>> signal(length);
+    for (size_t i = 0; i < length; i++) {
+        signal[i] = Complex<double>(std::sin(0.1 * static_cast<double>(i)) + static_cast<double>(i % 7), static_cast<double>(i % 3) - 1.0);
+    }
+    return signal;
+}
+
+double max_error(const std::vector<Complex<double>> &a, const std::vector<Complex<double>> &b) {
+    double error = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        const Complex<double> difference = a[i] - b[i];
+        error = maximum(error, maximum(std::fabs(difference.real_part()), std::fabs(difference.imag_part())));
+    }
+    return error;
+}
+
+// Direct evaluation of the definition, with the angles computed by the
+// standard library
+std::vector<Complex<double>> naive_dft(const std::vector<Complex<double>> &signal) {
+    const size_t length = signal.size();
+    std::vector<Complex<double>> result(length);
+    for (size_t k = 0; k < length; k++) {
+        double real = 0.0;
+        double imag = 0.0;
+        for (size_t n = 0; n < length; n++) {
+            const double angle = -2.0 * const_pi * static_cast<double>((k * n) % length) / static_cast<double>(length);
+            real += signal[n].real_part() * std::cos(angle) - signal[n].imag_part() * std::sin(angle);
+            imag += signal[n].real_part() * std::sin(angle) + signal[n].imag_part() * std::cos(angle);
+        }
+        result[k] = Complex<double>(real, imag);
+    }
+    return result;
+}
+
+// Compares the real transform with the complex one of the same signal
+bool check_real_transform(const size_t length) {
+    const Real_FFT_Plan<double> real_plan(length);
+    const FFT_Plan<double> plan(length);
+    std::vector<double> signal(length);
+    std::vector<Complex<double>> expected(length);
+    for (size_t i = 0; i < length; i++) {
+        signal[i] = std::cos(0.3 * static_cast<double>(i)) + static_cast<double>(i % 5);
+        expected[i] = Complex<double>(signal[i]);
+    }
+    plan.forward(expected);
+    std::vector<Complex<double>> spectrum(real_plan.spectrum_length());
+    real_plan.forward(signal.data(), spectrum.data());
+    expected.resize(spectrum.size());
+    const double error = max_error(spectrum, expected);
+    std::vector<double> output(length);
+    real_plan.inverse(spectrum.data(), output.data());
+    double round_trip = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        round_trip = maximum(round_trip, std::fabs(output[i] - signal[i]));
+    }
+    std::cout << "Real length " << length << ": error " << error << ", round trip error " << round_trip << std::endl;
+    return (error <= 1e-13 * static_cast<double>(length)) && (round_trip <= 1e-13 * static_cast<double>(length));
+}
+
+// The 2D transform is separable, so the reference applies the naive DFT
+// to the rows and then to the columns
+bool check_2d_transform(const size_t rows, const size_t cols) {
+    Matrix<Complex<double>> matrix(rows, cols);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            matrix(i, j) = Complex<double>(static_cast<double>((3 * i + j) % 7), std::sin(static_cast<double>(i * j)));
+        }
+    }
+    Matrix<Complex<double>> expected(rows, cols);
+    for (size_t i = 0; i < rows; i++) {
+        const std::vector<Complex<double>> row = naive_dft(std::vector<Complex<double>>(&matrix(i, 0), &matrix(i, 0) + cols));
+        std::copy(row.begin(), row.end(), &expected(i, 0));
+    }
+    for (size_t j = 0; j < cols; j++) {
+        std::vector<Complex<double>> col(rows);
+        for (size_t i = 0; i < rows; i++) {
+            col[i] = expected(i, j);
+        }
+        col = naive_dft(col);
+        for (size_t i = 0; i < rows; i++) {
+            expected(i, j) = col[i];
+        }
+    }
+    // Several threads must give the same result as a single one
+    Thread_Pool pool(4);
+    const FFT_2D_Plan<double> plan(rows, cols, &pool);
+    Matrix<Complex<double>> transform = matrix;
+    plan.forward(transform);
+    const double error = max_error(std::vector<Complex<double>>(transform.begin(), transform.end()), std::vector<Complex<double>>(expected.begin(), expected.end()));
+    plan.inverse(transform);
+    const double round_trip = max_error(std::vector<Complex<double>>(transform.begin(), transform.end()), std::vector<Complex<double>>(matrix.begin(), matrix.end()));
+    std::cout << "2D " << rows << "x" << cols << ": error " << error << ", round trip error " << round_trip << std::endl;
+    return (error <= 1e-11 * static_cast<double>(rows * cols)) && (round_trip <= 1e-13 * static_cast<double>(rows * cols)) && (transform == matrix);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t max_bits = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_MAX_BITS;
+    const size_t lengths[] = {1, 2, 3, 4, 5, 8, 12, 16, 31, 32, 100, 128, 243, 512, 1000, 1024};
+    for (auto length : lengths) {
+        const FFT_Plan<double> plan(length);
+        const std::vector<Complex<double>> signal = make_signal(length);
+        std::vector<Complex<double>> transform = signal;
+        plan.forward(transform);
+        const double error = max_error(transform, naive_dft(signal));
+        plan.inverse(transform);
+        const double round_trip = max_error(transform, signal);
+        std::cout << "Length " << length << ": error " << error << ", round trip error " << round_trip << std::endl;
+        if ((error > 1e-11 * static_cast<double>(length)) || (round_trip > 1e-13 * static_cast<double>(length))) {
+            std::cerr << "The FFT of length " << length << " was NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    for (auto length : lengths) {
+        if (!check_real_transform(length)) {
+            std::cerr << "The real FFT of length " << length << " was NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const size_t shapes[][2] = {{1, 1}, {4, 8}, {6, 10}, {33, 64}, {64, 5}};
+    for (auto shape : shapes) {
+        if (!check_2d_transform(shape[0], shape[1])) {
+            std::cerr << "The 2D FFT of " << shape[0] << "x" << shape[1] << " was NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "\nFFT performance (ns per point):\n";
+    for (size_t bits = 10; bits <= max_bits; bits += 2) {
+        const size_t length = static_cast<size_t>(1) << bits;
+        auto start = std::chrono::steady_clock::now();
+        const FFT_Plan<double> plan(length);
+        const double plan_ns = elapsed_ns(start);
+        const FFT_Plan<double> bluestein_plan(length - 1);
+        const std::vector<Complex<double>> signal = make_signal(length);
+        std::vector<Complex<double>> data = signal;
+        const size_t repetitions = maximum<size_t>((static_cast<size_t>(1) << 22) / length, 1);
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repetitions; r++) {
+            plan.forward(data);
+            plan.inverse(data);
+        }
+        const double radix_ns = elapsed_ns(start) / static_cast<double>(2 * repetitions);
+        if (max_error(data, signal) > 1e-9) {
+            std::cerr << "The FFT of length " << length << " did NOT return the original signal!\n";
+            return EXIT_FAILURE;
+        }
+        std::vector<double> real_signal(length);
+        std::vector<Complex<double>> spectrum(length / 2 + 1);
+        const Real_FFT_Plan<double> real_plan(length);
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repetitions; r++) {
+            real_plan.forward(real_signal.data(), spectrum.data());
+            real_plan.inverse(spectrum.data(), real_signal.data());
+        }
+        const double real_ns = elapsed_ns(start) / static_cast<double>(2 * repetitions);
+        data.resize(length - 1);
+        start = std::chrono::steady_clock::now();
+        bluestein_plan.forward(data);
+        const double bluestein_ns = elapsed_ns(start);
+        std::cout << "2^" << bits << " points: " << radix_ns / static_cast<double>(length) << " ns (plan " << plan_ns / static_cast<double>(length)
+                  << " ns), real input: " << real_ns / static_cast<double>(length) << " ns, " << (length - 1) << " points (Bluestein): " << bluestein_ns / static_cast<double>(length - 1) << " ns" << std::endl;
+    }
+    std::cout << "\n2D FFT performance (ns per point):\n";
+    const size_t side = static_cast<size_t>(1) << (max_bits / 2);
+    Matrix<Complex<double>> image(side, side);
+    for (size_t i = 0; i < side; i++) {
+        for (size_t j = 0; j < side; j++) {
+            image(i, j) = Complex<double>(static_cast<double>((i ^ j) % 13));
+        }
+    }
+    const size_t thread_counts[] = {1, 2, 4, std::thread::hardware_concurrency()};
+    for (auto threads : thread_counts) {
+        Thread_Pool pool(maximum<size_t>(threads, 1));
+        const FFT_2D_Plan<double> plan(side, side, &pool);
+        Matrix<Complex<double>> data = image;
+        const auto start = std::chrono::steady_clock::now();
+        plan.forward(data);
+        plan.inverse(data);
+        const double ns = elapsed_ns(start) / 2.0;
+        if (data != image) {
+            std::cerr << "The 2D FFT did NOT return the original image!\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << side << "x" << side << " with " << pool.threads() << " threads: " << ns / static_cast<double>(side * side) << " ns" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "../lib/half.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#define DEFAULT_SIZE 2048
+#define REPETITIONS 5
+
+// Every half value, except NaNs, must survive the round trip through float
+bool check_half_conversions(void) {
+    for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+        const Half half = Half::from_raw(static_cast<uint16_t>(bits));
+        const float value = static_cast<float>(half);
+        if (isNAN(value)) {
+            if (((bits & 0x7c00) != 0x7c00) || ((bits & 0x3ff) == 0)) {
+                return false;
+            }
+        } else if (Half(value).raw() != bits) {
+            return false;
+        }
+    }
+    // Rounding to nearest even, overflow and the smallest subnormal
+    return (Half(1.0f + 1.0f / 2048.0f).raw() == 0x3c00) && (Half(1.0f + 3.0f / 2048.0f).raw() == 0x3c02) && (Half(65520.0f).raw() == 0x7c00) && (Half(5.9604645e-8f).raw() == 0x0001) && (Half(-2.0f).raw() == 0xc000);
+}
+
+bool check_bfloat16_conversions(void) {
+    const float values[] = {0.0f, -1.0f, 3.140625f, 1e30f, -1e-30f};
+    for (auto value : values) {
+        if (are_close(static_cast<float>(BFloat16(value)), value, fabsf(value) / 128.0f) == false && value != 0.0f) {
+            return false;
+        }
+    }
+    return (BFloat16(1.0f + 1.0f / 256.0f).raw() == 0x3f80) && (BFloat16(1.0f + 3.0f / 256.0f).raw() == 0x3f82) && isNAN(static_cast<float>(BFloat16(NAN)));
+}
+
+template <typename Storage>
+double time_gemv(const Matrix<Storage> &matrix, const Vector<float> &vector, Vector<float> &result) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < REPETITIONS; r++) {
+        result = gemv(matrix, vector);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPETITIONS;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t size = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_SIZE;
+    if (!check_half_conversions() || !check_bfloat16_conversions()) {
+        std::cerr << "The 16-bit conversions are NOT correct!\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "All 16-bit conversions are correct\n\n";
+    Matrix<float> a(size, size);
+    a.random(-1.0f, 1.0f);
+    Vector<float> x(size);
+    x.random(-1.0f, 1.0f);
+    const Matrix<Half> a_half = convert<Half>(a);
+    const Matrix<BFloat16> a_bf16 = convert<BFloat16>(a);
+    Vector<float> y_float;
+    Vector<float> y_half;
+    Vector<float> y_bf16;
+    const double float_s = time_gemv(a, x, y_float);
+    const double half_s = time_gemv(a_half, x, y_half);
+    const double bf16_s = time_gemv(a_bf16, x, y_bf16);
+    // Each element has about 11 (half) or 8 (bfloat16) significant bits,
+    // and the products of a row add up randomly
+    const float tolerance = static_cast<float>(square_root<double>(static_cast<double>(size)));
+    if ((y_half.max_diff(y_float) > tolerance / 1024.0f) || (y_bf16.max_diff(y_float) > tolerance / 128.0f)) {
+        std::cerr << "The 16-bit GEMV is NOT accurate enough!\n";
+        return EXIT_FAILURE;
+    }
+    const double elements = static_cast<double>(size * size);
+    std::cout << "GEMV of a " << size << "x" << size << " matrix (matrix bandwidth):\n";
+    std::cout << "float:    " << float_s * 1e3 << " ms, " << elements * 4.0 / float_s / 1e9 << " GB/s\n";
+    std::cout << "half:     " << half_s * 1e3 << " ms, " << elements * 2.0 / half_s / 1e9 << " GB/s, max error " << y_half.max_diff(y_float) << "\n";
+    std::cout << "bfloat16: " << bf16_s * 1e3 << " ms, " << elements * 2.0 / bf16_s / 1e9 << " GB/s, max error " << y_bf16.max_diff(y_float) << "\n\n";
+    {
+        const size_t n = minimum<size_t>(size, 128);
+        Matrix<float> b(n, n);
+        b.random(-1.0f, 1.0f);
+        const Matrix<float> c = gemm(b, b);
+        const Matrix<float> c_half = gemm(convert<Half>(b), convert<Half>(b));
+        const Matrix<float> c_reference = b * b;
+        float error = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                error = maximum(error, fabsf(c_half(i, j) - c(i, j)));
+                if (fabsf(c(i, j) - c_reference(i, j)) > 1e-4f) {
+                    std::cerr << "The float GEMM is NOT correct!\n";
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        std::cout << "Half GEMM of " << n << "x" << n << " matrices, max error " << error << std::endl;
+        if (error > static_cast<float>(n) / 1024.0f) {
+            std::cerr << "The half GEMM is NOT accurate enough!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "../lib/hash-table.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../lib/dynamic-array.hpp"
+#include "../lib/random.hpp"
+
+#define DEFAULT_KEYS (1 << 20)
+#define LINEAR_LOOKUPS 64
+
+// Random inserts, updates and erases on a narrow range of keys, compared
+// with an array indexed by the key
+bool check_against_model(void) {
+    const size_t keys = 2000;
+    std::vector<bool> present(keys, false);
+    std::vector<long> model(keys, 0);
+    size_t model_length = 0;
+    Hash_Map<int, long> map;
+    Random random(42);
+    for (size_t step = 0; step < 200000; step++) {
+        const int key = static_cast<int>(random.next() % keys) - static_cast<int>(keys / 2);
+        const size_t slot = static_cast<size_t>(key + static_cast<int>(keys / 2));
+        const long value = static_cast<long>(step);
+        bool consistent = true;
+        switch (random.next() % 5) {
+            case 0:
+                consistent = (map.insert(key, value) == !present[slot]);
+                if (!present[slot]) {
+                    present[slot] = true;
+                    model[slot] = value;
+                    model_length++;
+                }
+                break;
+            case 1:
+                consistent = (map.erase(key) == present[slot]);
+                if (present[slot]) {
+                    present[slot] = false;
+                    model_length--;
+                }
+                break;
+            case 2:
+                map[key] += value;
+                if (!present[slot]) {
+                    present[slot] = true;
+                    model[slot] = 0;
+                    model_length++;
+                }
+                model[slot] += value;
+                break;
+            default:
+                consistent = (map.contains(key) == present[slot]) && (!present[slot] || (map.value_at(key) == model[slot]));
+                break;
+        }
+        if (!consistent || (map.length() != model_length)) {
+            std::cerr << "The hash map differs from the model at step " << step << ", with key " << key << "!\n";
+            return false;
+        }
+    }
+    size_t visited = 0;
+    for (const auto &entry : map) {
+        const size_t slot = static_cast<size_t>(entry.key + static_cast<int>(keys / 2));
+        if (!present[slot] || (entry.value != model[slot])) {
+            std::cerr << "The hash map has the unexpected entry " << entry << "!\n";
+            return false;
+        }
+        visited++;
+    }
+    Hash_Map<int, long> copy(map);
+    Hash_Map<int, long> moved(std::move(copy));
+    copy = moved;
+    if ((visited != model_length) || (copy.length() != model_length) || (moved.value_at(map.begin()->key) != map.begin()->value)) {
+        std::cerr << "The hash map was NOT properly iterated or copied!\n";
+        return false;
+    }
+    std::cout << "The hash map matched the model after 200000 random operations\n";
+    return true;
+}
+
+// Erasing shifts the elements back, so a table which is filled and
+// emptied many times never grows, and its lookups stay short
+bool check_erase(void) {
+    Hash_Set<long> set;
+    set.reserve(1000);
+    const size_t capacity = set.capacity();
+    for (long round = 0; round < 100; round++) {
+        for (long i = 0; i < 1000; i++) {
+            set.insert(round * 1000 + i);
+        }
+        for (long i = 0; i < 1000; i += 2) {
+            set.erase(round * 1000 + i);
+        }
+        for (long i = 0; i < 1000; i++) {
+            if (set.contains(round * 1000 + i) != (i % 2 == 1)) {
+                std::cerr << "The hash set lost a key after erasing, in round " << round << "!\n";
+                return false;
+            }
+        }
+        set.clear();
+    }
+    if (set.capacity() != capacity) {
+        std::cerr << "The hash set grew from " << capacity << " to " << set.capacity() << " while reserved!\n";
+        return false;
+    }
+    // Each value holds a reference, which erasing and destroying release
+    const std::shared_ptr<int> shared = std::make_shared<int>(7);
+    {
+        Hash_Map<int, std::shared_ptr<int>> references;
+        for (int i = 0; i < 1000; i++) {
+            references.insert(i, shared);
+        }
+        for (int i = 0; i < 1000; i += 3) {
+            references.erase(i);
+        }
+        if ((references.length() != 666) || (shared.use_count() != 667) || (references.value_at(500) != shared)) {
+            std::cerr << "The hash map of shared pointers was NOT properly built!\n";
+            return false;
+        }
+    }
+    if (shared.use_count() != 1) {
+        std::cerr << shared.use_count() - 1 << " values were NOT destroyed by the hash map!\n";
+        return false;
+    }
+    std::cout << "Erasing kept the capacity of the hash set at " << capacity << std::endl;
+    return true;
+}
+
+bool check_floating_keys(void) {
+    Hash_Map<double, std::string> map;
+    for (int i = 0; i < 1000; i++) {
+        map.insert(0.1 * i, std::to_string(i));
+    }
+    bool refused = false;
+    try {
+        map.insert(std::nan(""), "NaN");
+    } catch (const std::runtime_error &error) {
+        refused = true;
+    }
+    if (!refused || map.insert(-0.0, "negative zero") || (map.value_at(-0.0) != "0") || (map[0.1 * 999] != "999") || map.contains(0.1 * 1000)) {
+        std::cerr << "The hash map with floating point keys was NOT properly built!\n";
+        return false;
+    }
+    // Each value is copied from the previous element, also when the
+    // insertion grows the table and moves that element
+    Hash_Map<int, std::string> chain;
+    chain.insert(0, "a string too long to be stored inline");
+    for (int i = 1; i < 1000; i++) {
+        chain.insert(i, chain[i - 1]);
+    }
+    for (const auto &entry : chain) {
+        if (entry.value != "a string too long to be stored inline") {
+            std::cerr << "The value inserted at key " << entry.key << " was NOT copied from the table!\n";
+            return false;
+        }
+    }
+    std::cout << "The hash map accepted floating point keys, with -0.0 equal to 0.0\n\n";
+    return true;
+}
+
+double nanoseconds_since(const std::chrono::steady_clock::time_point start, const size_t operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(operations);
+}
+
+// Nanoseconds per insert and lookup in the hash set, and per lookup with
+// a linear find in an array of the same keys
+template <typename Number>
+void benchmark(const char *name, const size_t count, Number (*make)(uint64_t)) {
+    std::vector<Number> keys;
+    std::vector<Number> missing;
+    Random random(7);
+    for (size_t i = 0; i < count; i++) {
+        keys.push_back(make(random.next()));
+        missing.push_back(make(random.next()));
+    }
+    auto start = std::chrono::steady_clock::now();
+    {
+        Hash_Set<Number> set;
+        for (const Number key : keys) {
+            set.insert(key);
+        }
+    }
+    const double inserting = nanoseconds_since(start, count);
+    Hash_Set<Number> set;
+    set.reserve(count);
+    start = std::chrono::steady_clock::now();
+    for (const Number key : keys) {
+        set.insert(key);
+    }
+    const double inserting_reserved = nanoseconds_since(start, count);
+    size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (const Number key : keys) {
+        found += set.contains(key);
+    }
+    const double hits = nanoseconds_since(start, count);
+    start = std::chrono::steady_clock::now();
+    for (const Number key : missing) {
+        found += set.contains(key);
+    }
+    const double misses = nanoseconds_since(start, count);
+    Dynamic_Array<Number> array;
+    for (const Number key : keys) {
+        array.push(key);
+    }
+    const size_t lookups = LINEAR_LOOKUPS;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        found += array.find(keys[(i * count) / lookups + count / (2 * lookups)]);
+    }
+    const double linear = nanoseconds_since(start, lookups);
+    std::cout << name << " keys, " << set.length() << " in a table of " << set.capacity() << " slots:\n"
+              << "    insert: " << inserting << " ns, " << inserting_reserved << " ns after reserve\n"
+              << "    lookup: " << hits << " ns for present keys, " << misses << " ns for missing keys\n"
+              << "    linear find: " << linear << " ns, " << linear / hits << " times slower (" << found << ")\n";
+}
+
+long make_long(const uint64_t bits) {
+    return static_cast<long>(bits >> 1);
+}
+
+double make_double(const uint64_t bits) {
+    return unit_interval(bits);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t keys = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_KEYS;
+    if (keys == 0) {
+        std::cerr << "The number of keys must be positive!\n";
+        return EXIT_FAILURE;
+    }
+    Hash_Map<int, std::string> map;
+    for (int i = 0; i < 8; i++) {
+        map.insert(i * i, "square of " + std::to_string(i));
+    }
+    std::cout << "Hash map after insertion:\n"
+              << map << std::endl;
+    std::cout << "Erase key 9: " << map.erase(9) << std::endl;
+    std::cout << "Contains key 9: " << map.contains(9) << std::endl;
+    std::cout << "Value of key 16: " << map.value_at(16) << std::endl;
+    std::cout << "For each loop in the hash map:\n";
+    for (const auto &entry : map) {
+        std::cout << entry.key << ", ";
+    }
+    std::cout << std::endl
+              << std::endl;
+    if (!check_against_model() || !check_erase() || !check_floating_keys()) {
+        return EXIT_FAILURE;
+    }
+    benchmark("Integer", keys, make_long);
+    benchmark("Floating point", keys, make_double);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
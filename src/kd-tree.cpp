@@ -0,0 +1,102 @@
+#include "../lib/kd-tree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define DEFAULT_POINTS (1 << 17)
+#define DEFAULT_QUERIES 2000
+#define NEIGHBORS 8
+#define RADIUS 0.02
+
+double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double squared_distance(const Vector<double> &a, const Vector<double> &b) {
+    double sum = 0.0;
+    for (size_t d = 0; d < a.length(); d++) {
+        sum += (a[d] - b[d]) * (a[d] - b[d]);
+    }
+    return sum;
+}
+
+std::vector<size_t> brute_force_nearest(const std::vector<Vector<double>> &points, const Vector<double> &query, const size_t k) {
+    std::vector<std::pair<double, size_t>> distances(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        distances[i] = std::make_pair(squared_distance(points[i], query), i);
+    }
+    std::partial_sort(distances.begin(), distances.begin() + static_cast<long>(k), distances.end());
+    std::vector<size_t> result(k);
+    for (size_t i = 0; i < k; i++) {
+        result[i] = distances[i].second;
+    }
+    return result;
+}
+
+std::vector<size_t> brute_force_radius(const std::vector<Vector<double>> &points, const Vector<double> &query, const double radius) {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (squared_distance(points[i], query) <= radius * radius) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t count = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_POINTS;
+    const size_t queries_count = (argc >= 3) ? strtoul(argv[2], nullptr, 10) : DEFAULT_QUERIES;
+    srand(3);
+    std::vector<Vector<double>> points(count, Vector<double>(3));
+    for (auto &p : points) {
+        for (auto &value : p) {
+            value = random_number<double>(0.0, 1.0);
+        }
+    }
+    std::vector<Vector<double>> queries(queries_count, Vector<double>(3));
+    for (auto &q : queries) {
+        for (auto &value : q) {
+            value = random_number<double>(0.0, 1.0);
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    const KD_Tree<double> tree(points);
+    const double build_ms = elapsed_ms(start);
+    start = std::chrono::steady_clock::now();
+    const auto nearest = tree.nearest(queries, NEIGHBORS);
+    const double nearest_ms = elapsed_ms(start);
+    start = std::chrono::steady_clock::now();
+    const auto within = tree.radius(queries, RADIUS);
+    const double radius_ms = elapsed_ms(start);
+    // Brute force is slow, so only a sample of the queries is checked
+    const size_t checked = minimum<size_t>(queries_count, 100);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < checked; i++) {
+        if (nearest[i] != brute_force_nearest(points, queries[i], minimum<size_t>(NEIGHBORS, count))) {
+            std::cerr << "The nearest neighbours of query " << i << " were NOT properly found!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const double brute_nearest_ms = elapsed_ms(start) * static_cast<double>(queries_count) / static_cast<double>(checked);
+    // A k larger than the tree asks for all the points
+    if (tree.nearest(queries[0], SIZE_MAX).size() != count) {
+        std::cerr << "Asking for all the nearest neighbours did NOT return every point!\n";
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < checked; i++) {
+        std::vector<size_t> found = within[i];
+        std::sort(found.begin(), found.end());
+        if (found != brute_force_radius(points, queries[i], RADIUS)) {
+            std::cerr << "The points within the radius of query " << i << " were NOT properly found!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "k-d tree of " << count << " 3D points built in " << build_ms << " ms" << std::endl;
+    std::cout << queries_count << " queries of the " << NEIGHBORS << " nearest neighbours: " << nearest_ms << " ms" << std::endl;
+    std::cout << queries_count << " queries within radius " << RADIUS << ": " << radius_ms << " ms" << std::endl;
+    std::cout << "Brute force nearest neighbours (estimated): " << brute_nearest_ms << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
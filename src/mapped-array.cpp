@@ -0,0 +1,225 @@
+#include "../lib/mapped-array.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define DEFAULT_RECORDS (1 << 20)
+
+struct Record {
+    uint64_t id;
+    double value;
+
+    bool operator==(const Record &other) const { return (id == other.id) && (value == other.value); }
+};
+
+Record make_record(const size_t index) {
+    return Record{index, 0.5 * static_cast<double>(index)};
+}
+
+// Files in the temporary directory, unique to this process
+std::string temporary_path(const char *name) {
+    return "/tmp/" + std::string(name) + "-" + std::to_string(getpid()) + ".bin";
+}
+
+bool check_persistence(const std::string &path) {
+    std::remove(path.c_str());
+    {
+        Mapped_Array<Record> records(path);
+        for (size_t i = 0; i < 3000; i++) {
+            records.push(make_record(i));
+        }
+        records.sync();
+    }
+    {
+        Mapped_Array<Record> reopened(path);
+        if ((reopened.length() != 3000) || (reopened.capacity() != 4096)) {
+            std::cerr << "The mapped array was reopened with length " << reopened.length() << " and capacity " << reopened.capacity() << "!\n";
+            return false;
+        }
+        for (size_t i = 0; i < reopened.length(); i++) {
+            if (!(reopened[i] == make_record(i))) {
+                std::cerr << "The mapped array was NOT properly reopened, at index " << i << "!\n";
+                return false;
+            }
+        }
+        reopened.push(reopened[0]);
+        Mapped_Array<Record> moved(std::move(reopened));
+        moved.pop();
+        moved.pop();
+        moved.advise(Mapped_Access::random);
+        moved[10].value = -1.0;
+    }
+    {
+        Mapped_Array<Record> reopened(path);
+        if ((reopened.length() != 2999) || (reopened.value_at(10).value != -1.0) || (reopened.find(make_record(2998)) != 2998)) {
+            std::cerr << "The changes to the mapped array were NOT kept!\n";
+            return false;
+        }
+    }
+    {
+        // A valid header with no room for elements
+        Mapped_Array<Record> empty(path + ".empty");
+        empty.push(make_record(1));
+        empty.clear();
+    }
+    if (truncate((path + ".empty").c_str(), mapped_array_data_offset) != 0) {
+        std::cerr << "The file of the mapped array could NOT be truncated!\n";
+        return false;
+    }
+    {
+        Mapped_Array<Record> empty(path + ".empty");
+        const size_t capacity = empty.capacity();
+        for (size_t i = 0; i < 10; i++) {
+            empty.push(make_record(i));
+        }
+        if (capacity != 0) {
+            std::cerr << "The truncated mapped array was reopened with capacity " << capacity << "!\n";
+            return false;
+        }
+    }
+    {
+        Mapped_Array<Record> grown(path + ".empty");
+        if ((grown.length() != 10) || !(grown[9] == make_record(9))) {
+            std::cerr << "The mapped array without room for elements did NOT grow properly!\n";
+            return false;
+        }
+    }
+    std::remove((path + ".empty").c_str());
+    std::string reason;
+    try {
+        Mapped_Array<Record> missing("/nonexistent-directory/mapped-array.bin");
+    } catch (const std::runtime_error &error) {
+        reason = error.what();
+    }
+    if (reason.find(std::strerror(ENOENT)) == std::string::npos) {
+        std::cerr << "Opening a mapped array in a missing directory failed with \"" << reason << "\"!\n";
+        return false;
+    }
+    bool refused = false;
+    try {
+        Mapped_Array<double> other_type(path);
+    } catch (const std::runtime_error &error) {
+        refused = true;
+    }
+    std::FILE *text = std::fopen(path.c_str(), "w");
+    std::fputs("Some text, which is not a mapped array\n", text);
+    std::fclose(text);
+    try {
+        Mapped_Array<Record> not_an_array(path);
+        refused = false;
+    } catch (const std::runtime_error &error) {
+    }
+    std::remove(path.c_str());
+    if (!refused) {
+        std::cerr << "A file which is not a mapped array of this type was opened!\n";
+        return false;
+    }
+    std::cout << "The mapped array kept its elements after being closed and reopened\n\n";
+    return true;
+}
+
+double milliseconds_since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Appends the records, then compares reopening the mapped array with
+// reading the same records from a plain file
+void benchmark(const std::string &path, const size_t count) {
+    std::remove(path.c_str());
+    auto start = std::chrono::steady_clock::now();
+    {
+        Mapped_Array<Record> records(path);
+        for (size_t i = 0; i < count; i++) {
+            records.push(make_record(i));
+        }
+    }
+    const double appending = milliseconds_since(start);
+    start = std::chrono::steady_clock::now();
+    {
+        Mapped_Array<Record> records(path);
+        records.sync();
+    }
+    const double syncing = milliseconds_since(start);
+    start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    {
+        Mapped_Array<Record> records(path);
+        length = records.length();
+    }
+    const double reopening = milliseconds_since(start);
+    double sum = 0.0;
+    start = std::chrono::steady_clock::now();
+    {
+        Mapped_Array<Record> records(path);
+        records.advise(Mapped_Access::sequential);
+        for (const Record &record : records) {
+            sum += record.value;
+        }
+    }
+    const double scanning = milliseconds_since(start);
+    const std::string plain_path = path + ".plain";
+    {
+        std::vector<Record> records;
+        for (size_t i = 0; i < count; i++) {
+            records.push_back(make_record(i));
+        }
+        std::FILE *plain = std::fopen(plain_path.c_str(), "wb");
+        std::fwrite(records.data(), sizeof(Record), records.size(), plain);
+        std::fclose(plain);
+    }
+    start = std::chrono::steady_clock::now();
+    {
+        std::vector<Record> records(count);
+        std::FILE *plain = std::fopen(plain_path.c_str(), "rb");
+        length += std::fread(records.data(), sizeof(Record), records.size(), plain);
+        std::fclose(plain);
+        sum += records[count / 2].value;
+    }
+    const double reading = milliseconds_since(start);
+    std::remove(plain_path.c_str());
+    std::remove(path.c_str());
+    std::cout << "Appending " << count << " records of " << sizeof(Record) << " bytes:\n"
+              << "    append: " << appending << " ms (" << static_cast<double>(count) / appending / 1e3 << " million per second)\n"
+              << "    sync: " << syncing << " ms\n"
+              << "    reopen: " << reopening << " ms\n"
+              << "    sequential scan after reopening: " << scanning << " ms\n"
+              << "    reading a plain file instead: " << reading << " ms (" << length << ", " << sum << ")\n";
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t records = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_RECORDS;
+    const std::string path = temporary_path("mapped-array");
+    std::remove(path.c_str());
+    {
+        Mapped_Array<int> array(path);
+        for (int i = 0; i < 16; i++) {
+            array.push(i);
+        }
+        std::cout << "Array after insertion:\n"
+                  << array << std::endl;
+        std::cout << "Pop a value from array: " << array.pop() << std::endl;
+        std::cout << "Value at index 5: " << array.value_at(5) << std::endl;
+        std::cout << "Find value 10 at position " << array.find(10) << std::endl;
+        std::cout << "For each loop in the array:\n";
+        for (auto &value : array) {
+            std::cout << value << ", ";
+        }
+        std::cout << std::endl
+                  << std::endl;
+    }
+    std::remove(path.c_str());
+    if (!check_persistence(path)) {
+        return EXIT_FAILURE;
+    }
+    benchmark(path, records);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
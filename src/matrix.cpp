@@ -1,3 +1,4 @@
+#include "../lib/complex.hpp"
 #include "../lib/matrix.hpp"
 
 #include <cstdlib>
@@ -120,5 +121,37 @@ int main(void) {
         std::cout << "Matrix F = (A - B):\n"
                   << F << std::endl;
     }
+    {
+        Matrix<Complex<double>> Z(2, 2);
+        Z(0, 0) = Complex<double>(1.0, 1.0);
+        Z(0, 1) = Complex<double>(2.0);
+        Z(1, 0) = Complex<double>(0.0, -1.0);
+        Z(1, 1) = Complex<double>(3.0, 2.0);
+        std::cout << "Complex matrix Z:\n"
+                  << Z << std::endl;
+        const auto product = Z * Z.inverse();
+        const auto determinant = Z.determinant();
+        const auto expected = Complex<double>(1.0, 1.0) * Complex<double>(3.0, 2.0) - Complex<double>(2.0) * Complex<double>(0.0, -1.0);
+        if ((product == Matrix<Complex<double>>::identity(2)) && (determinant == expected) && (Z.transpose().transpose() == Z)) {
+            std::cout << "The complex matrix operations were properly calculated!\n";
+        } else {
+            std::cerr << "The complex matrix operations were NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    {
+        // Large enough for the parallel transpose
+        Matrix<double> G(700, 300);
+        G.random(-1.0, 1.0, 3);
+        const auto T = G.transpose();
+        for (size_t i = 0; i < G.rows(); i++) {
+            for (size_t j = 0; j < G.cols(); j++) {
+                if (T(j, i) != G(i, j)) {
+                    std::cerr << "The transpose matrix was NOT properly calculated!\n";
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "../lib/quantized.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "../lib/half.hpp"
+
+#define DEFAULT_SIZE 2048
+#define REPETITIONS 5
+
+template <typename Function>
+double average_seconds(const Function &function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < REPETITIONS; r++) {
+        function();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPETITIONS;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t size = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_SIZE;
+    Matrix<float> a(size, size);
+    a.random(-1.0f, 1.0f);
+    Vector<float> x(size);
+    x.random(-1.0f, 1.0f);
+    const Quantized_Matrix q(a);
+    {
+        // Each element is rounded to half of the step of its row
+        const Matrix<float> restored = q.dequantize();
+        float error = 0.0f;
+        for (size_t i = 0; i < size; i++) {
+            for (size_t j = 0; j < size; j++) {
+                error = maximum(error, std::fabs(restored(i, j) - a(i, j)) / q.scale(i));
+            }
+        }
+        std::cout << "Dequantization error: " << error << " steps" << std::endl;
+        if (error > 0.5001f) {
+            std::cerr << "The matrix was NOT properly quantized!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    {
+        // Rows longer than a block, whose dot products and zero point
+        // corrections don't fit 32 bits
+        const size_t cols = 2 * quantized_block_length + 17;
+        Matrix<float> wide(2, cols);
+        Vector<float> ones(cols);
+        for (size_t j = 0; j < cols; j++) {
+            wide(0, j) = 1.0f;
+            wide(1, j) = -1.0f;
+            ones[j] = 1.0f;
+        }
+        const Vector<float> y = gemv(Quantized_Matrix(wide), ones);
+        const float expected = static_cast<float>(cols);
+        if ((std::fabs(y[0] - expected) > 1e-3f * expected) || (std::fabs(y[1] + expected) > 1e-3f * expected)) {
+            std::cerr << "The quantized GEMV of rows with " << cols << " columns gave " << y[0] << " and " << y[1] << "!\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << "Rows with " << cols << " columns were multiplied without overflow" << std::endl;
+    }
+    Vector<float> y_float;
+    Vector<float> y_int8;
+    const double float_s = average_seconds([&] { y_float = gemv(a, x); });
+    const double int8_s = average_seconds([&] { y_int8 = gemv(q, x); });
+    const float max_error = y_int8.max_diff(y_float);
+    const float relative_error = max_error / y_float.max_abs();
+    std::cout << "GEMV of a " << size << "x" << size << " matrix:\n";
+    std::cout << "float: " << float_s * 1e3 << " ms\n";
+    std::cout << "int8:  " << int8_s * 1e3 << " ms (" << float_s / int8_s << "x), max error " << max_error << ", relative to the largest output " << relative_error << "\n";
+    if (relative_error > 0.05f) {
+        std::cerr << "The quantized GEMV is NOT accurate enough!\n";
+        return EXIT_FAILURE;
+    }
+    {
+        const size_t n = minimum<size_t>(size, 256);
+        Matrix<float> b(n, n);
+        b.random(-1.0f, 1.0f);
+        Matrix<float> c(n, n);
+        c.random(-1.0f, 1.0f);
+        Matrix<float> c_float;
+        Matrix<float> c_int8;
+        const double gemm_float_s = average_seconds([&] { c_float = gemm(b, c); });
+        const Quantized_Matrix qb(b);
+        const double gemm_int8_s = average_seconds([&] { c_int8 = gemm(qb, c); });
+        float error = 0.0f;
+        float largest = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                error = maximum(error, std::fabs(c_int8(i, j) - c_float(i, j)));
+                largest = maximum(largest, std::fabs(c_float(i, j)));
+            }
+        }
+        std::cout << "\nGEMM of " << n << "x" << n << " matrices:\n";
+        std::cout << "float: " << gemm_float_s * 1e3 << " ms\n";
+        std::cout << "int8:  " << gemm_int8_s * 1e3 << " ms (" << gemm_float_s / gemm_int8_s << "x), max error " << error << ", relative to the largest output " << error / largest << "\n";
+        if (error / largest > 0.05f) {
+            std::cerr << "The quantized GEMM is NOT accurate enough!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "../lib/random.hpp"
+#include "../lib/matrix.hpp"
+#include "../lib/vector.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define DEFAULT_LENGTH (1 << 20)
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool check_moments(const Vector<double> &values, const double expected_mean, const double expected_variance) {
+    const double mean = values.mean();
+    double variance = 0.0;
+    for (size_t i = 0; i < values.length(); i++) {
+        variance += (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= static_cast<double>(values.length());
+    std::cout << "mean " << mean << " (expected " << expected_mean << "), variance " << variance << " (expected " << expected_variance << ")" << std::endl;
+    return (fabs(mean - expected_mean) < 0.01) && (fabs(variance - expected_variance) < 0.02 * expected_variance);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    {
+        Random first(42);
+        Random second(42);
+        Random other(42, 1);
+        const uint64_t value = first.next();
+        if ((value != second.next()) || (value == other.next())) {
+            std::cerr << "The generator streams were NOT properly seeded!\n";
+            return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < 1000; i++) {
+            const float number = first.uniform(-1.0f, 1.0f);
+            if ((number < -1.0f) || (number > 1.0f)) {
+                std::cerr << "The number " << number << " is outside of the range!\n";
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    {
+        // Floats are 2 apart above 2^24, so a quarter of the numbers would
+        // round up to max
+        const float min = 16777216.0f;
+        const float max = 16777220.0f;
+        std::vector<float> numbers(1000);
+        fill_uniform(numbers.data(), numbers.size(), min, max, 3);
+        Random generator(3);
+        for (size_t i = 0; i < numbers.size(); i++) {
+            const float number = generator.uniform(min, max);
+            if ((numbers[i] < min) || (numbers[i] >= max) || (number < min) || (number >= max)) {
+                std::cerr << "The numbers " << std::to_string(numbers[i]) << " and " << std::to_string(number) << " are NOT in [" << std::to_string(min) << ", " << std::to_string(max) << ")!\n";
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    Vector<double> values(length);
+    values.random(-1.0, 1.0, 7);
+    std::cout << "Uniform in [-1, 1): ";
+    if ((values.min() < -1.0) || (values.max() >= 1.0) || !check_moments(values, 0.0, 1.0 / 3.0)) {
+        std::cerr << "The uniform distribution was NOT properly generated!\n";
+        return EXIT_FAILURE;
+    }
+    {
+        // The same seed must give the same numbers, whatever the number of
+        // threads which generated them
+        Vector<double> again(length);
+        Thread_Pool *const pool = parallel_policy().pool;
+        Thread_Pool single(1);
+        parallel_policy().pool = &single;
+        again.random(-1.0, 1.0, 7);
+        parallel_policy().pool = pool;
+        if (again != values) {
+            std::cerr << "The numbers depend on the number of threads!\n";
+            return EXIT_FAILURE;
+        }
+        if (again.random(-1.0, 1.0) == values) {
+            std::cerr << "Two calls without a seed gave the same numbers!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    values.random_normal(2.0, 3.0, 7);
+    std::cout << "Normal with mean 2 and deviation 3: ";
+    if (!check_moments(values, 2.0, 9.0)) {
+        std::cerr << "The normal distribution was NOT properly generated!\n";
+        return EXIT_FAILURE;
+    }
+    {
+        Matrix<float> matrix(3, 5);
+        matrix.random(0.0f, 1.0f, 11);
+        std::cout << "Random matrix:\n"
+                  << matrix << std::endl;
+        for (auto value : matrix) {
+            if ((value < 0.0f) || (value > 1.0f)) {
+                std::cerr << "The matrix has a number outside of the range!\n";
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    srand(7);
+    for (size_t i = 0; i < length; i++) {
+        values[i] = random_number<double>(-1.0, 1.0);
+    }
+    checksum += values[length / 2];
+    const double rand_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    values.random(-1.0, 1.0, 7);
+    checksum += values[length / 2];
+    const double uniform_ns = elapsed_ns(start);
+    start = std::chrono::steady_clock::now();
+    values.random_normal(0.0, 1.0, 7);
+    checksum += values[length / 2];
+    const double normal_ns = elapsed_ns(start);
+    std::cout << "\nFilling " << length << " doubles (checksum " << checksum << ")" << std::endl;
+    std::cout << "rand():       " << rand_ns / static_cast<double>(length) << " ns per number" << std::endl;
+    std::cout << "fill_uniform: " << uniform_ns / static_cast<double>(length) << " ns per number" << std::endl;
+    std::cout << "fill_normal:  " << normal_ns / static_cast<double>(length) << " ns per number" << std::endl;
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "../lib/scalar.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#define DEFAULT_SAMPLES (1 << 16)
+
+// One sweep of a function over a range of inputs. Logarithmic ranges are
+// sampled evenly in the exponent. The reference is computed in long double,
+// and the error bound is the one documented in scalar.hpp
+struct Sweep {
+    const char *name;
+    double min;
+    double max;
+    bool logarithmic;
+    double (*function)(const double);
+    double (*libm)(const double);
+    long double (*reference)(const long double);
+    double bound;
+};
+
+double wrap_square_root(const double x) { return square_root(x); }
+double wrap_cube_root(const double x) { return root(x, 3); }
+double wrap_seventh_root(const double x) { return root(x, 7); }
+double wrap_power(const double x) { return power(x, 17); }
+double wrap_exponential(const double x) { return exponential(x); }
+double wrap_sine(const double x) { return sine(x); }
+double wrap_cosine(const double x) { return cosine(x); }
+double wrap_tangent(const double x) { return tangent(x); }
+double wrap_arctangent(const double x) { return arctangent(x); }
+// atan2 is swept along the unit circle, by the angle
+double wrap_atan2(const double t) { return atan2(std::sin(t), std::cos(t)); }
+
+double libm_square_root(const double x) { return std::sqrt(x); }
+double libm_cube_root(const double x) { return std::cbrt(x); }
+double libm_seventh_root(const double x) { return std::pow(x, 1.0 / 7.0); }
+double libm_power(const double x) { return std::pow(x, 17.0); }
+double libm_exponential(const double x) { return std::exp(x); }
+double libm_sine(const double x) { return std::sin(x); }
+double libm_cosine(const double x) { return std::cos(x); }
+double libm_tangent(const double x) { return std::tan(x); }
+double libm_arctangent(const double x) { return std::atan(x); }
+double libm_atan2(const double t) { return std::atan2(std::sin(t), std::cos(t)); }
+
+long double reference_square_root(const long double x) { return std::sqrt(x); }
+long double reference_cube_root(const long double x) { return std::cbrt(x); }
+long double reference_seventh_root(const long double x) { return std::pow(x, 1.0L / 7.0L); }
+long double reference_power(const long double x) { return std::pow(x, 17.0L); }
+long double reference_exponential(const long double x) { return std::exp(x); }
+long double reference_sine(const long double x) { return std::sin(x); }
+long double reference_cosine(const long double x) { return std::cos(x); }
+long double reference_tangent(const long double x) { return std::tan(x); }
+long double reference_arctangent(const long double x) { return std::atan(x); }
+long double reference_atan2(const long double t) {
+    const double t_double = static_cast<double>(t);
+    return std::atan2(static_cast<long double>(std::sin(t_double)), static_cast<long double>(std::cos(t_double)));
+}
+
+// Distance to the reference, in units of the spacing of doubles around it
+double ulp_error(const double value, const long double expected) {
+    const double rounded = static_cast<double>(expected);
+    if (isNAN(expected)) {
+        return isNAN(value) ? 0.0 : INFINITY;
+    } else if ((value == rounded) && (static_cast<long double>(value) == expected)) {
+        return 0.0;
+    } else if (std::isinf(rounded)) {
+        return (value == rounded) ? 0.0 : INFINITY;
+    }
+    const double spacing = std::nextafter(std::fabs(rounded), INFINITY) - std::fabs(rounded);
+    return static_cast<double>(std::fabs(static_cast<long double>(value) - expected) / static_cast<long double>(spacing));
+}
+
+std::vector<double> make_inputs(const Sweep &sweep, const size_t samples) {
+    std::vector<double> inputs(samples);
+    for (size_t i = 0; i < samples; i++) {
+        const double fraction = (samples > 1) ? static_cast<double>(i) / static_cast<double>(samples - 1) : 0.0;
+        if (sweep.logarithmic) {
+            const double low = std::log(sweep.min);
+            inputs[i] = std::exp(low + fraction * (std::log(sweep.max) - low));
+        } else {
+            inputs[i] = sweep.min + fraction * (sweep.max - sweep.min);
+        }
+    }
+    return inputs;
+}
+
+double time_per_call(double (*function)(const double), const std::vector<double> &inputs, double &checksum) {
+    const auto start = std::chrono::steady_clock::now();
+    for (const double x : inputs) {
+        checksum += function(x);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(inputs.size());
+}
+
+// The compile-time tables, against the factorial loop and long double
+// sine and cosine. Quiet when the output is CSV
+bool check_tables(const bool quiet) {
+    static_assert(factorial(0) == 1 && factorial(20) == 2432902008176640000ULL && factorial(66) == 0, "factorial is wrong at compile time");
+    static_assert(inverse_factorial_table[3] == 1.0 / 6.0, "The inverse factorial table is wrong at compile time");
+    static_assert(maximum(power(2.0, 3), 7.0) == 8.0 && are_close(power(3.0, 2), 9.0, 1e-15), "power is wrong at compile time");
+    static_assert(Sine_Table<2>::sine[0] == 0.0 && Sine_Table<2>::cosine[0] == 1.0, "The sine table is wrong at compile time");
+    uint64_t expected = 1;
+    // Past 20!, the loop wraps around, and reaches 0 at 66!
+    for (uint64_t i = 0; i <= 70; i++) {
+        expected *= (i > 1) ? i : 1;
+        if (factorial(i) != expected) {
+            std::cerr << "The factorial of " << i << " was NOT properly calculated: " << factorial(i) << "\n";
+            return false;
+        }
+    }
+    if (factorial(10000000) != 0) {
+        std::cerr << "The factorial of 10000000 was NOT properly calculated: " << factorial(10000000) << "\n";
+        return false;
+    }
+    const size_t length = 1 << 12;
+    double worst = 0.0;
+    for (size_t j = 0; j <= length / 2; j++) {
+        const long double angle = static_cast<long double>(j) / length * 1.57079632679489661923132169163975144L;
+        worst = maximum(worst, ulp_error(Sine_Table<length>::sine[j], std::sin(angle)));
+        worst = maximum(worst, ulp_error(Sine_Table<length>::cosine[j], std::cos(angle)));
+    }
+    if (worst > 1.0) {
+        std::cerr << "The sine table is " << worst << " ulp away from the reference!\n";
+        return false;
+    }
+    if (!quiet) {
+        std::cout << "The compile-time tables were properly calculated, within " << worst << " ulp!\n\n";
+    }
+    return true;
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t samples = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_SAMPLES;
+    const bool csv = (argc >= 3) && (strcmp(argv[2], "csv") == 0);
+    if (samples == 0) {
+        std::cerr << "The number of samples must be positive!\n";
+        return EXIT_FAILURE;
+    }
+    if (!check_tables(csv)) {
+        return EXIT_FAILURE;
+    }
+    const double pi = const_pi;
+    const Sweep sweeps[] = {
+        {"square_root", 0.0, 4.0, false, wrap_square_root, libm_square_root, reference_square_root, 1.0},
+        {"square_root", 1e-300, 1e300, true, wrap_square_root, libm_square_root, reference_square_root, 1.0},
+        {"root(x, 3)", 1e-300, 1e300, true, wrap_cube_root, libm_cube_root, reference_cube_root, 2.0},
+        {"root(x, 7)", 1e-300, 1e300, true, wrap_seventh_root, libm_seventh_root, reference_seventh_root, 2.0},
+        {"power(x, 17)", 0.5, 2.0, false, wrap_power, libm_power, reference_power, 17.0},
+        {"exponential", -1.0, 1.0, false, wrap_exponential, libm_exponential, reference_exponential, 1.0},
+        {"exponential", -745.0, 709.0, false, wrap_exponential, libm_exponential, reference_exponential, 1.0},
+        {"sine", -pi, pi, false, wrap_sine, libm_sine, reference_sine, 1.0},
+        {"sine", -1e5, 1e5, false, wrap_sine, libm_sine, reference_sine, 1.0},
+        {"cosine", -pi, pi, false, wrap_cosine, libm_cosine, reference_cosine, 1.0},
+        {"cosine", -1e5, 1e5, false, wrap_cosine, libm_cosine, reference_cosine, 1.0},
+        {"tangent", -1.5, 1.5, false, wrap_tangent, libm_tangent, reference_tangent, 2.5},
+        {"tangent", -1e5, 1e5, false, wrap_tangent, libm_tangent, reference_tangent, 2.5},
+        {"arctangent", -10.0, 10.0, false, wrap_arctangent, libm_arctangent, reference_arctangent, 1.0},
+        {"arctangent", 1e-10, 1e10, true, wrap_arctangent, libm_arctangent, reference_arctangent, 1.0},
+        {"atan2", -pi, pi, false, wrap_atan2, libm_atan2, reference_atan2, 2.0},
+    };
+    if (csv) {
+        std::cout << "function,min,max,samples,ns_per_call,calls_per_second,libm_ns_per_call,max_ulp,mean_ulp,worst_input\n";
+    } else {
+        std::cout << std::left << std::setw(14) << "function" << std::setw(24) << "range" << std::setw(12) << "ns/call" << std::setw(14) << "calls/s"
+                  << std::setw(12) << "libm ns" << std::setw(10) << "max ulp" << std::setw(12) << "mean ulp"
+                  << "worst input\n";
+    }
+    bool success = true;
+    double checksum = 0.0;
+    for (const Sweep &sweep : sweeps) {
+        const std::vector<double> inputs = make_inputs(sweep, samples);
+        const double ns = time_per_call(sweep.function, inputs, checksum);
+        const double libm_ns = time_per_call(sweep.libm, inputs, checksum);
+        double max_error = 0.0, total_error = 0.0, worst = inputs[0];
+        for (const double x : inputs) {
+            const double error = ulp_error(sweep.function(x), sweep.reference(static_cast<long double>(x)));
+            total_error += error;
+            if (error > max_error) {
+                max_error = error;
+                worst = x;
+            }
+        }
+        const double mean_error = total_error / static_cast<double>(inputs.size());
+        if (csv) {
+            std::cout << std::setprecision(17) << sweep.name << "," << sweep.min << "," << sweep.max << "," << samples << "," << ns << "," << 1e9 / ns << "," << libm_ns << ","
+                      << max_error << "," << mean_error << "," << worst << "\n";
+        } else {
+            std::ostringstream range;
+            range << "[" << sweep.min << ", " << sweep.max << "]";
+            std::cout << std::setprecision(4) << std::setw(14) << sweep.name << std::setw(24) << range.str() << std::setw(12) << ns << std::setw(14) << 1e9 / ns
+                      << std::setw(12) << libm_ns << std::setw(10) << max_error << std::setw(12) << mean_error << std::setprecision(17) << worst << "\n";
+        }
+        if (!(max_error <= sweep.bound)) {
+            std::cerr << sweep.name << " is " << max_error << " ulp away from the reference at " << std::setprecision(17) << worst << ", above its bound of " << sweep.bound << " ulp!\n";
+            success = false;
+        }
+    }
+    if (!csv) {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
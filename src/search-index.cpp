@@ -0,0 +1,84 @@
+#include "../lib/search-index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define DEFAULT_LENGTH (1 << 20)
+#define DEFAULT_QUERIES (1 << 20)
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    const size_t queries = (argc >= 3) ? strtoul(argv[2], nullptr, 10) : DEFAULT_QUERIES;
+    Vector<double> values(length);
+    for (size_t i = 0; i < length; i++) {
+        values[i] = 2.0 * static_cast<double>(i);
+    }
+    // Half of the keys are present in the vector, the other half fall
+    // between two values or outside of the range
+    Vector<double> keys(queries);
+    srand(7);
+    for (size_t i = 0; i < queries; i++) {
+        keys[i] = static_cast<double>(rand() % (2 * length + 4)) - 2.0;
+    }
+    const Search_Index<double> index(values);
+    {
+        // Keys below values[0] used to underflow the binary search
+        Vector<double> small(3);
+        small[0] = 1.0;
+        small[1] = 2.0;
+        small[2] = 3.0;
+        const Search_Index<double> small_index(small);
+        if ((small.binary_search(0.0) != 0) || (small_index.lower_bound(0.0) != 0) || (small_index.lower_bound(4.0) != 3) || (small_index.search(4.0) != 2)) {
+            std::cerr << "Keys outside of the range were NOT properly handled!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::vector<size_t> expected(queries);
+    for (size_t i = 0; i < queries; i++) {
+        expected[i] = static_cast<size_t>(std::lower_bound(values.begin(), values.end(), keys[i]) - values.begin());
+    }
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; i++) {
+        checksum += values.binary_search(keys[i]);
+    }
+    const double loop_ns = elapsed_ns(start);
+    // Timed like the loop above, and checked in a separate pass
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; i++) {
+        checksum += index.lower_bound(keys[i]);
+    }
+    const double single_ns = elapsed_ns(start);
+    for (size_t i = 0; i < queries; i++) {
+        if (index.lower_bound(keys[i]) != expected[i]) {
+            std::cerr << "The search index returned a wrong position for " << keys[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    start = std::chrono::steady_clock::now();
+    const std::vector<size_t> batch = index.lower_bound(keys);
+    const double batch_ns = elapsed_ns(start);
+    if (batch != expected) {
+        std::cerr << "The batched lookup returned wrong positions!\n";
+        return EXIT_FAILURE;
+    }
+    const std::vector<size_t> closest = index.search(keys);
+    for (size_t i = 0; i < queries; i += maximum<size_t>(queries / 64, 1)) {
+        if (closest[i] != values.search(keys[i])) {
+            std::cerr << "The closest value to " << keys[i] << " was NOT properly found!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << queries << " lookups in a vector of " << length << " values (checksum " << checksum << ")" << std::endl;
+    std::cout << "Vector::binary_search:        " << loop_ns / static_cast<double>(queries) << " ns per lookup" << std::endl;
+    std::cout << "Search_Index::lower_bound:    " << single_ns / static_cast<double>(queries) << " ns per lookup" << std::endl;
+    std::cout << "Search_Index batched lookup:  " << batch_ns / static_cast<double>(queries) << " ns per lookup" << std::endl;
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
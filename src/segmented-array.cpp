@@ -0,0 +1,169 @@
+#include "../lib/segmented-array.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define DEFAULT_PUSHES (1 << 22)
+
+// Remembers where it was built, so elements which were moved, or copied,
+// to another address can be told apart
+struct Placed {
+    const Placed *origin;
+    bool copied;
+
+    Placed(void) : origin(this), copied(false) {}
+    Placed(const Placed &other) : origin(other.origin), copied(true) {}
+    Placed(Placed &&other) noexcept : origin(other.origin), copied(other.copied) {}
+    Placed &operator=(const Placed &other) = delete;
+};
+
+bool check_stable_addresses(void) {
+    Segmented_Array<long, 64> array;
+    for (long i = 0; i < 1000; i++) {
+        array.push(i);
+    }
+    const long *first = &array[0];
+    const long *middle = &array[500];
+    const long &last = array[999];
+    for (long i = 1000; i < 100000; i++) {
+        array.push(array[static_cast<size_t>(i - 1000)] + 1000);
+    }
+    if ((first != &array[0]) || (middle != &array[500]) || (&last != &array[999]) || (last != 999)) {
+        std::cerr << "The elements of the segmented array were moved!\n";
+        return false;
+    }
+    for (size_t i = 0; i < array.length(); i++) {
+        if (array[i] != static_cast<long>(i)) {
+            std::cerr << "The segmented array was NOT properly built, at index " << i << "!\n";
+            return false;
+        }
+    }
+    std::cout << "The elements kept their addresses while the array grew to " << array.length() << " elements\n";
+    return true;
+}
+
+bool check_elements(void) {
+    {
+        Segmented_Array<std::string, 16> strings;
+        for (int i = 0; i < 100; i++) {
+            strings.push("string number " + std::to_string(i));
+        }
+        strings.emplace_back(3, 'x');
+        Segmented_Array<std::string, 16> copy(strings);
+        Segmented_Array<std::string, 16> moved(std::move(copy));
+        copy = moved;
+        if ((strings.length() != 101) || (strings[100] != "xxx") || (moved.find("string number 42") != 42) || (copy[50] != "string number 50") ||
+            !std::equal(strings.begin(), strings.end(), copy.begin())) {
+            std::cerr << "The segmented array of strings was NOT properly built!\n";
+            return false;
+        }
+        for (int i = 0; i < 60; i++) {
+            strings.pop();
+        }
+        strings.shrink_to_fit();
+        if ((strings.pop() != "string number 40") || (strings.capacity() != 48)) {
+            std::cerr << "The segmented array of strings was NOT properly shrunk!\n";
+            return false;
+        }
+    }
+    {
+        Segmented_Array<Placed, 32> placed;
+        for (int i = 0; i < 1000; i++) {
+            placed.emplace_back();
+        }
+        for (const Placed &element : placed) {
+            if (element.origin != &element) {
+                std::cerr << "Growing the segmented array moved its elements!\n";
+                return false;
+            }
+        }
+        const Placed *last = &placed[999];
+        const Placed popped = placed.pop();
+        if ((popped.origin != last) || popped.copied) {
+            std::cerr << "The segmented array copied the popped element instead of moving it!\n";
+            return false;
+        }
+    }
+    std::cout << "Growing the segmented array moved no elements\n\n";
+    return true;
+}
+
+std::string make_string(const size_t value) {
+    return std::to_string(value);
+}
+
+size_t length_of(const std::string &value) {
+    return value.size();
+}
+
+long make_long(const size_t value) {
+    return static_cast<long>(value);
+}
+
+size_t length_of(const long value) {
+    return static_cast<size_t>(value);
+}
+
+// Pushes per second, the slowest single push, timed in a second run, and
+// the time of reading the elements by index
+template <typename Array, typename Number>
+void benchmark(const char *name, const size_t pushes, Number (*make)(size_t)) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t sum = 0;
+    {
+        Array array;
+        for (size_t i = 0; i < pushes; i++) {
+            array.push(make(i));
+        }
+        sum += length_of(array[pushes / 2]);
+    }
+    const std::chrono::duration<double> pushing = std::chrono::steady_clock::now() - start;
+    double slowest = 0.0;
+    Array array;
+    for (size_t i = 0; i < pushes; i++) {
+        const auto before = std::chrono::steady_clock::now();
+        array.push(make(i));
+        slowest = std::max(slowest, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - before).count());
+    }
+    const auto sum_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < array.length(); i++) {
+        sum += length_of(array[i]);
+    }
+    const std::chrono::duration<double, std::milli> summing = std::chrono::steady_clock::now() - sum_start;
+    std::cout << name << ":\n"
+              << "    " << static_cast<double>(pushes) / pushing.count() / 1e6 << " million pushes per second\n"
+              << "    slowest push: " << slowest << " ms\n"
+              << "    indexed reads: " << summing.count() << " ms (" << sum << ")\n";
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t pushes = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_PUSHES;
+    Segmented_Array<int, 8> array;
+    for (int i = 0; i < 16; i++) {
+        array.push(i);
+    }
+    std::cout << "Array after insertion:\n"
+              << array << std::endl;
+    std::cout << "Pop a value from array: " << array.pop() << std::endl;
+    std::cout << "Value at index 5: " << array.value_at(5) << std::endl;
+    std::cout << "Find value 10 at position " << array.find(10) << std::endl;
+    std::cout << "For each loop in the array:\n";
+    for (auto &value : array) {
+        std::cout << value << ", ";
+    }
+    std::cout << std::endl
+              << std::endl;
+    if (!check_stable_addresses() || !check_elements()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "Pushing " << pushes << " long integers:\n";
+    benchmark<Dynamic_Array<long>>("Dynamic_Array", pushes, make_long);
+    benchmark<Segmented_Array<long>>("Segmented_Array", pushes, make_long);
+    std::cout << "Pushing " << pushes / 4 << " strings:\n";
+    benchmark<Dynamic_Array<std::string>>("Dynamic_Array", pushes / 4, make_string);
+    benchmark<Segmented_Array<std::string>>("Segmented_Array", pushes / 4, make_string);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
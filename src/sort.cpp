@@ -0,0 +1,106 @@
+#include "../lib/sort.hpp"
+#include "../lib/vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#define DEFAULT_LENGTH (1 << 18)
+
+typedef void (*Sort_Function)(double *array, const size_t length);
+
+void std_sort(double *array, const size_t length) {
+    std::sort(array, array + length);
+}
+
+std::vector<double> make_input(const char *const pattern, const size_t length) {
+    std::vector<double> input(length);
+    srand(42);
+    for (size_t i = 0; i < length; i++) {
+        const double value = random_number<double>(-1e6, 1e6);
+        if (strcmp(pattern, "random") == 0) {
+            input[i] = value;
+        } else if (strcmp(pattern, "sorted") == 0) {
+            input[i] = static_cast<double>(i);
+        } else if (strcmp(pattern, "reversed") == 0) {
+            input[i] = static_cast<double>(length - i);
+        } else {
+            input[i] = static_cast<double>(rand() % 16);
+        }
+    }
+    return input;
+}
+
+bool check_special_values(void) {
+    const double values[] = {3.0, NAN, -0.0, 0.0, -INFINITY, -NAN, 1.0, -0.0, INFINITY, -2.0};
+    const size_t length = sizeof(values) / sizeof(values[0]);
+    double radix[length];
+    double intro[length];
+    std::copy(values, values + length, radix);
+    std::copy(values, values + length, intro);
+    radix_sort(radix, length);
+    introsort(intro, length);
+    std::cout << "Radix sort with NaN and signed zeros: ";
+    for (size_t i = 0; i < length; i++) {
+        std::cout << radix[i] << " ";
+    }
+    std::cout << std::endl;
+    // The two NaNs must be at the end, and the negative zeros before the positive one
+    if (!isNAN(radix[length - 1]) || !isNAN(radix[length - 2]) || !isNAN(intro[length - 1]) || !isNAN(intro[length - 2])) {
+        return false;
+    }
+    if (!std::signbit(radix[2]) || !std::signbit(radix[3]) || std::signbit(radix[4])) {
+        return false;
+    }
+    return std::is_sorted(radix, radix + length - 2) && std::is_sorted(intro, intro + length - 2);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    const char *const patterns[] = {"random", "sorted", "reversed", "duplicates"};
+    const char *const names[] = {"std::sort", "introsort", "radix_sort", "parallel_sort"};
+    const Sort_Function functions[] = {std_sort, introsort<double>, radix_sort<double>, parallel_sort<double>};
+    if (!check_special_values()) {
+        std::cerr << "NaN or signed zeros were NOT properly sorted!\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "\nSorting " << length << " doubles (ns per element):\n";
+    std::cout << std::left << std::setw(12) << "input";
+    for (auto name : names) {
+        std::cout << std::setw(16) << name;
+    }
+    std::cout << std::endl;
+    for (auto pattern : patterns) {
+        const std::vector<double> input = make_input(pattern, length);
+        std::vector<double> expected = input;
+        std::sort(expected.begin(), expected.end());
+        std::cout << std::setw(12) << pattern;
+        for (auto function : functions) {
+            std::vector<double> array = input;
+            const auto start = std::chrono::steady_clock::now();
+            function(array.data(), array.size());
+            const auto stop = std::chrono::steady_clock::now();
+            if (array != expected) {
+                std::cerr << "\nThe " << pattern << " input was NOT properly sorted!\n";
+                return EXIT_FAILURE;
+            }
+            const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            std::cout << std::setw(16) << std::fixed << std::setprecision(2) << (ns / static_cast<double>(length));
+        }
+        std::cout << std::endl;
+    }
+    {
+        Vector<double> vector(1000);
+        vector.random(-1.0, 1.0);
+        vector.sort();
+        if (!vector.is_sorted()) {
+            std::cerr << "The vector was NOT properly sorted!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include "../lib/vector-math.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#define DEFAULT_LENGTH (1 << 18)
+
+double elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Distance to the exact result, in units of the spacing of Floating around it
+template <typename Floating>
+double ulp_error(const Floating value, const double expected) {
+    const Floating rounded = static_cast<Floating>(expected);
+    if (isNAN(expected)) {
+        return isNAN(value) ? 0.0 : INFINITY;
+    } else if ((value == rounded) || (static_cast<double>(value) == expected)) {
+        return 0.0;
+    } else if (std::isinf(rounded)) {
+        return INFINITY;
+    }
+    const Floating spacing = std::nextafter(std::fabs(rounded), std::numeric_limits<Floating>::infinity()) - std::fabs(rounded);
+    return std::fabs(static_cast<double>(value) - expected) / static_cast<double>(spacing);
+}
+
+template <typename Floating>
+std::vector<Floating> make_input(const size_t length, const double min, const double max, const uint64_t seed) {
+    std::vector<Floating> input(length);
+    fill_uniform(input.data(), length, static_cast<Floating>(min), static_cast<Floating>(max), seed);
+    return input;
+}
+
+// Checks the array versions against <cmath>, and returns the worst errors
+template <typename Floating>
+bool check_arrays(const size_t length, const double range, const double bound, const double exponential_bound) {
+    const std::vector<Floating> x = make_input<Floating>(length, -range, range, 1);
+    const std::vector<Floating> e = make_input<Floating>(length, -745.0, 709.0, 2);
+    std::vector<Floating> s(length), c(length), exp(length), single(length);
+    sincos(x.data(), s.data(), c.data(), length);
+    sine(x.data(), single.data(), length);
+    exponential(e.data(), exp.data(), length);
+    double sine_error = 0.0, cosine_error = 0.0, exponential_error = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        const double value = static_cast<double>(x[i]);
+        sine_error = maximum(sine_error, ulp_error(s[i], std::sin(value)));
+        cosine_error = maximum(cosine_error, ulp_error(c[i], std::cos(value)));
+        exponential_error = maximum(exponential_error, ulp_error(exp[i], std::exp(static_cast<double>(e[i]))));
+        if (single[i] != s[i]) {
+            std::cerr << "sine and sincos disagree for " << value << std::endl;
+            return false;
+        }
+    }
+    std::cout << "Arrays of " << sizeof(Floating) * 8 << "-bit values in [-" << range << ", " << range << "]: max error " << sine_error
+              << " ulp for sine, " << cosine_error << " ulp for cosine and " << exponential_error << " ulp for exponential\n";
+    return (sine_error <= bound) && (cosine_error <= bound) && (exponential_error <= exponential_bound);
+}
+
+bool check_scalar(const size_t length) {
+    const std::vector<double> x = make_input<double>(length, -1.6e6, 1.6e6, 3);
+    const std::vector<double> small = make_input<double>(length, -10.0, 10.0, 4);
+    const std::vector<double> e = make_input<double>(length, -745.0, 709.0, 5);
+    double error = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        double s, c;
+        sincos(x[i], s, c);
+        error = maximum(error, ulp_error(s, std::sin(x[i])));
+        error = maximum(error, ulp_error(c, std::cos(x[i])));
+        error = maximum(error, ulp_error(sine(small[i]), std::sin(small[i])));
+        error = maximum(error, ulp_error(cosine(small[i]), std::cos(small[i])));
+        error = maximum(error, ulp_error(exponential(e[i]), std::exp(e[i])));
+    }
+    std::cout << "Scalar sine, cosine and exponential: max error " << error << " ulp\n";
+    return (error <= 1.0);
+}
+
+// Inputs spread over the whole range of exponents
+std::vector<double> make_magnitudes(const size_t length, const uint64_t seed) {
+    std::vector<double> input = make_input<double>(length, -700.0, 700.0, seed);
+    for (double &value : input) {
+        value = std::exp(value);
+    }
+    return input;
+}
+
+bool check_roots(const size_t length) {
+    static_assert(power(2.0, 10) == 1024.0, "power must run at compile time");
+    const std::vector<double> x = make_magnitudes(length, 9);
+    std::vector<double> roots(length), inverse_roots(length);
+    square_root(x.data(), roots.data(), length);
+    inverse_square_root(x.data(), inverse_roots.data(), length);
+    double error = 0.0, inverse_error = 0.0, cube_error = 0.0, root_error = 0.0, power_error = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        // std::sqrt is correctly rounded
+        const double exact = std::sqrt(x[i]);
+        const double inverse = static_cast<double>(1.0L / std::sqrt(static_cast<long double>(x[i])));
+        error = maximum(error, ulp_error(square_root(x[i]), exact));
+        inverse_error = maximum(inverse_error, ulp_error(inverse_square_root(x[i]), inverse));
+        inverse_error = maximum(inverse_error, ulp_error(inverse_roots[i], inverse));
+        cube_error = maximum(cube_error, ulp_error(root(x[i], 3), static_cast<double>(std::cbrt(static_cast<long double>(x[i])))));
+        // The n-th root y is checked through y^n/x - 1, about n times its relative error
+        const uint64_t n = 3 + i % 100;
+        const long double y = static_cast<long double>(root(x[i], n));
+        root_error = maximum(root_error, static_cast<double>(std::fabs(power(y, n) / static_cast<long double>(x[i]) - 1.0L)) / static_cast<double>(n));
+        const double base = 1.0 + x[i] / (1.0 + x[i]);
+        // Rounding errors double on each squaring, so they grow with n
+        power_error = maximum(power_error, ulp_error(power(base, n), std::pow(base, static_cast<double>(n))) / static_cast<double>(n));
+        if (roots[i] != exact) {
+            std::cerr << "The square root of " << x[i] << " over an array was NOT properly calculated!\n";
+            return false;
+        }
+    }
+    root_error /= std::numeric_limits<double>::epsilon();
+    std::cout << "square_root: " << error << " ulp, inverse_square_root: " << inverse_error << " ulp, root(x, 3): " << cube_error
+              << " ulp, root(x, n): " << root_error << " epsilon, power(x, n): " << power_error << " ulp per unit of n\n";
+    const bool special = (square_root(-0.0) == 0.0) && std::signbit(square_root(-0.0)) && isNAN(square_root(-1.0)) && (square_root(1e-310) == std::sqrt(1e-310)) &&
+                         (inverse_square_root(INFINITY) == 0.0) && (root(-8.0, 3) == -2.0) && isNAN(root(-16.0, 4)) && (root(0.0, 5) == 0.0) && (power(-2.0, 3) == -8.0);
+    return special && (error <= 1.0) && (inverse_error <= 2.0) && (cube_error <= 2.0) && (root_error <= 2.0) && (power_error <= 1.0);
+}
+
+// The arctangent series used before, kept to compare the running times
+double series_arctangent(const double value) {
+    if (are_close(std::fabs(value), 1.0, scalar_precision)) {
+        return (sign(value) * const_pi / 4.0);
+    } else if (std::fabs(value) < 1.0) {
+        double result = value;
+        for (uint64_t i = 1; i < scalar_iterations; i++) {
+            const double term = (i % 2 ? -1.0 : 1.0) * power(value, 2 * i + 1) / static_cast<double>(2 * i + 1);
+            result += term;
+            if (are_close(term, 0.0, scalar_precision)) {
+                break;
+            }
+        }
+        return result;
+    }
+    double result = const_pi / 2.0 * (value > 1.0 ? 1.0 : -1.0);
+    for (uint64_t i = 1; i < scalar_iterations; i++) {
+        const double term = (i % 2 ? -1.0 : 1.0) / (power(value, 2 * i - 1) * static_cast<double>(2 * i - 1));
+        result += term;
+        if (are_close(term, 0.0, scalar_precision)) {
+            break;
+        }
+    }
+    return result;
+}
+
+bool check_arctangent(const size_t length) {
+    const std::vector<double> magnitudes = make_magnitudes(length, 11);
+    const std::vector<double> x = make_input<double>(length, -1.0, 1.0, 12);
+    std::vector<double> y(length), angles(length), arrays(length);
+    for (size_t i = 0; i < length; i++) {
+        y[i] = (i % 2 == 0) ? 1e-3 * magnitudes[i] : -1e-3 * magnitudes[i];
+    }
+    arctangent(y.data(), arrays.data(), length);
+    atan2(y.data(), x.data(), angles.data(), length);
+    double error = 0.0, array_error = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        error = maximum(error, ulp_error(arctangent(y[i]), std::atan(y[i])));
+        error = maximum(error, ulp_error(atan2(y[i], x[i]), std::atan2(y[i], x[i])));
+        array_error = maximum(array_error, ulp_error(arrays[i], std::atan(y[i])));
+        array_error = maximum(array_error, ulp_error(angles[i], std::atan2(y[i], x[i])));
+    }
+    std::cout << "arctangent and atan2: " << error << " ulp, over arrays: " << array_error << " ulp\n";
+    const double values[] = {0.0, -0.0, 1.0, -1.0, 1e-300, INFINITY, -INFINITY};
+    std::vector<double> special_y, special_x;
+    for (const double b : values) {
+        for (const double a : values) {
+            const double angle = atan2(b, a);
+            if ((angle != std::atan2(b, a)) || (std::signbit(angle) != std::signbit(std::atan2(b, a)))) {
+                std::cerr << "atan2(" << b << ", " << a << ") = " << angle << " differs from " << std::atan2(b, a) << std::endl;
+                return false;
+            }
+            special_y.push_back(b);
+            special_x.push_back(a);
+        }
+    }
+    special_y.push_back(NAN);
+    special_x.push_back(1.0);
+    special_y.push_back(1.0);
+    special_x.push_back(NAN);
+    // The same special values, through the packs
+    std::vector<double> special_angles(special_y.size());
+    atan2(special_y.data(), special_x.data(), special_angles.data(), special_y.size());
+    for (size_t i = 0; i < special_y.size(); i++) {
+        const double expected = std::atan2(special_y[i], special_x[i]);
+        if ((ulp_error(special_angles[i], expected) > 1.0) || (std::signbit(special_angles[i]) != std::signbit(expected))) {
+            std::cerr << "atan2 over arrays of (" << special_y[i] << ", " << special_x[i] << ") = " << special_angles[i] << " differs from " << expected << std::endl;
+            return false;
+        }
+    }
+    return (error <= 1.0) && (array_error <= 2.0) && isNAN(atan2(static_cast<double>(NAN), 1.0)) && (arctangent(static_cast<double>(INFINITY)) == const_pi / 2.0);
+}
+
+bool check_special_values(void) {
+    const double values[] = {NAN, INFINITY, -INFINITY, -0.0, 1e300, -745.5, 709.8, 1e-310};
+    const size_t length = sizeof(values) / sizeof(values[0]);
+    double s[length], c[length], e[length];
+    sincos(values, s, c, length);
+    exponential(values, e, length);
+    for (size_t i = 0; i < length; i++) {
+        double expected_s, expected_c;
+        sincos(values[i], expected_s, expected_c);
+        const double expected_e = exponential(values[i]);
+        // The array versions fall back to the scalar ones out of their range
+        if ((ulp_error(s[i], expected_s) > 2.0) || (ulp_error(c[i], expected_c) > 2.0) || (ulp_error(e[i], std::exp(values[i])) > 1.0) || (ulp_error(expected_e, std::exp(values[i])) > 1.0)) {
+            std::cerr << "Special value " << values[i] << " was NOT properly handled: sin " << s[i] << ", cos " << c[i] << ", exp " << e[i] << std::endl;
+            return false;
+        }
+    }
+    return !std::signbit(sine(0.0)) && std::signbit(sine(-0.0)) && (exponential(1e-320) == 1.0);
+}
+
+template <typename Function>
+double time_per_element(const size_t length, const Function &function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return elapsed_ns(start) / static_cast<double>(length);
+}
+
+int main(const int argc, const char *const argv[]) {
+    const size_t length = (argc >= 2) ? strtoul(argv[1], nullptr, 10) : DEFAULT_LENGTH;
+    if (!check_scalar(length) || !check_special_values()) {
+        std::cerr << "The scalar functions are NOT within 1 ulp!\n";
+        return EXIT_FAILURE;
+    }
+    if (!check_arctangent(length)) {
+        std::cerr << "The arctangent is NOT within its error bounds!\n";
+        return EXIT_FAILURE;
+    }
+    if (!check_roots(length)) {
+        std::cerr << "The roots are NOT within their error bounds!\n";
+        return EXIT_FAILURE;
+    }
+    if (!check_arrays<double>(length, 10.0, 2.0, 1.0) || !check_arrays<double>(length, 1.5e6, 2.0, 1.0) || !check_arrays<float>(length, 10.0, 2.5, 1.0) || !check_arrays<float>(length, 8000.0, 2.5, 1.0)) {
+        std::cerr << "The array functions are NOT within their error bounds!\n";
+        return EXIT_FAILURE;
+    }
+    {
+        Vector<double> v(3);
+        v[0] = 0.0;
+        v[1] = const_pi / 2.0;
+        v[2] = 1.0;
+        const Vector<double> s = sine(v);
+        const Vector<double> e = exponential(v);
+        if (!are_close(s[1], 1.0, scalar_precision) || !are_close(e[2], const_euler, scalar_precision) || (cosine(v)[0] != 1.0)) {
+            std::cerr << "The vector functions were NOT properly calculated!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const std::vector<double> x = make_input<double>(length, -1e3, 1e3, 6);
+    const std::vector<float> y = make_input<float>(length, -1e3, 1e3, 7);
+    const std::vector<double> z = make_input<double>(length, -500.0, 500.0, 8);
+    std::vector<double> output(length), other(length);
+    std::vector<float> output_float(length);
+    double checksum = 0.0;
+    std::cout << "\nTime per element, over " << length << " values:\n";
+    std::cout << "std::sin:                   " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += std::sin(x[i]);
+        }
+    }) << " ns\n";
+    std::cout << "sine:                       " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += sine(x[i]);
+        }
+    }) << " ns\n";
+    std::cout << "sine over a double array:   " << time_per_element(length, [&]() { sine(x.data(), output.data(), length); }) << " ns\n";
+    std::cout << "sine over a float array:    " << time_per_element(length, [&]() { sine(y.data(), output_float.data(), length); }) << " ns\n";
+    std::cout << "sincos over a double array: " << time_per_element(length, [&]() { sincos(x.data(), output.data(), other.data(), length); }) << " ns\n";
+    std::cout << "std::exp:                   " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += std::exp(z[i]);
+        }
+    }) << " ns\n";
+    std::cout << "exponential:                " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += exponential(z[i]);
+        }
+    }) << " ns\n";
+    std::cout << "exponential over an array:  " << time_per_element(length, [&]() { exponential(z.data(), output.data(), length); }) << " ns\n";
+    const std::vector<double> magnitudes = make_magnitudes(length, 10);
+    std::cout << "std::sqrt:                  " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += std::sqrt(magnitudes[i]);
+        }
+    }) << " ns\n";
+    std::cout << "square_root:                " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += square_root(magnitudes[i]);
+        }
+    }) << " ns\n";
+    std::cout << "square_root over an array:  " << time_per_element(length, [&]() { square_root(magnitudes.data(), output.data(), length); }) << " ns\n";
+    std::cout << "std::cbrt:                  " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += std::cbrt(magnitudes[i]);
+        }
+    }) << " ns\n";
+    std::cout << "root(x, 3):                 " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += root(magnitudes[i], 3);
+        }
+    }) << " ns\n";
+    std::cout << "power(x, 1000):             " << time_per_element(length, [&]() {
+        for (size_t i = 0; i < length; i++) {
+            checksum += power(1.0 + 1e-4 * x[i], 1000);
+        }
+    }) << " ns\n";
+    // The old series got slower as |x| got close to 1, so it is only timed
+    // on a few values of each range
+    const size_t series_length = minimum<size_t>(length, 1 << 10);
+    const double ranges[][2] = {{0.0, 0.5}, {0.9, 0.999}, {2.0, 1000.0}};
+    for (const auto &range : ranges) {
+        const std::vector<double> t = make_input<double>(length, range[0], range[1], 13);
+        std::cout << "arctangent over [" << range[0] << ", " << range[1] << "]: " << time_per_element(length, [&]() {
+            for (size_t i = 0; i < length; i++) {
+                checksum += arctangent(t[i]);
+            }
+        }) << " ns, series " << time_per_element(series_length, [&]() {
+            for (size_t i = 0; i < series_length; i++) {
+                checksum += series_arctangent(t[i]);
+            }
+        }) << " ns, std::atan " << time_per_element(length, [&]() {
+            for (size_t i = 0; i < length; i++) {
+                checksum += std::atan(t[i]);
+            }
+        }) << " ns, array " << time_per_element(length, [&]() { arctangent(t.data(), output.data(), length); }) << " ns\n";
+    }
+    std::cout << "(checksum " << checksum << ")\n";
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
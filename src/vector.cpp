@@ -2,6 +2,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <utility>
 
 int main(void) {
     Vector<double> a(3);
@@ -67,6 +68,51 @@ int main(void) {
     auto f = a - b;
     std::cout << "Vector f = (a - b):\n"
               << f << std::endl;
+    {
+        // Long vectors are processed in parallel chunks, and the
+        // reductions must not depend on how the chunks were scheduled
+        const size_t length = 1 << 20;
+        Vector<double> x(length);
+        Vector<double> y(length);
+        for (size_t i = 0; i < length; i++) {
+            x[i] = static_cast<double>(i % 1000) / 7.0;
+            y[i] = static_cast<double>(i % 333) / 3.0;
+        }
+        const double parallel_dot = x * y;
+        const double parallel_mean = (x - y).mean();
+        const double parallel_norm = (x + y * 2.0).norm();
+        parallel_policy().threshold = SIZE_MAX;
+        const double serial_dot = x * y;
+        const double serial_mean = (x - y).mean();
+        const double serial_norm = (x + y * 2.0).norm();
+        parallel_policy().threshold = parallel_threshold;
+        if ((parallel_dot == serial_dot) && (parallel_mean == serial_mean) && (parallel_norm == serial_norm) && (x == x * 1.0)) {
+            std::cout << "Parallel reductions over " << length << " elements match the serial ones\n\n";
+        } else {
+            std::cerr << "The parallel reductions do NOT match the serial ones!\n";
+            return EXIT_FAILURE;
+        }
+    }
+    {
+        // Short vectors live in the inline storage, and resizing keeps the
+        // elements and only reallocates when the capacity is exceeded
+        Vector<double> g(2);
+        g[0] = 1.0;
+        g[1] = 2.0;
+        const size_t inline_capacity = g.capacity();
+        g.resize(3);
+        g[2] = 3.0;
+        g.resize(100);
+        const size_t grown_capacity = g.capacity();
+        g.resize(10);
+        g.resize(50);
+        Vector<double> h(std::move(g));
+        if ((inline_capacity != vector_inline_capacity) || (h.capacity() != grown_capacity) || (h[0] != 1.0) || (h[1] != 2.0) || (h[2] != 3.0) || (g.length() != 0)) {
+            std::cerr << "The vector was NOT properly resized!\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << "Vector h kept its elements through resizes, with capacity " << h.capacity() << "\n\n";
+    }
     std::cout << "For each loop in the vector e:\n";
     for (auto value : e) {
         std::cout << value << ", ";